@@ -18,6 +18,9 @@
 #include "lib7842/api/odometry/settler.hpp"
 
 #include "lib7842/api/other/global.hpp"
+#include "lib7842/api/other/jet.hpp"
+#include "lib7842/api/other/memo.hpp"
+#include "lib7842/api/other/quadrature.hpp"
 #include "lib7842/api/other/units.hpp"
 #include "lib7842/api/other/utility.hpp"
 
@@ -28,13 +31,20 @@
 
 #include "lib7842/api/positioning/spline/arc.hpp"
 #include "lib7842/api/positioning/spline/bezier.hpp"
+#include "lib7842/api/positioning/spline/bezierTree.hpp"
+#include "lib7842/api/positioning/spline/bspline.hpp"
+#include "lib7842/api/positioning/spline/clothoid.hpp"
+#include "lib7842/api/positioning/spline/fit.hpp"
 #include "lib7842/api/positioning/spline/hermite.hpp"
+#include "lib7842/api/positioning/spline/lengthTable.hpp"
 #include "lib7842/api/positioning/spline/line.hpp"
 #include "lib7842/api/positioning/spline/mesh.hpp"
 #include "lib7842/api/positioning/spline/parametric.hpp"
 #include "lib7842/api/positioning/spline/piecewise.hpp"
+#include "lib7842/api/positioning/spline/polynomial.hpp"
 #include "lib7842/api/positioning/spline/spline.hpp"
 #include "lib7842/api/positioning/spline/stepper.hpp"
+#include "lib7842/api/positioning/spline/view.hpp"
 
 #include "lib7842/api/purePursuit/pathFollower.hpp"
 #include "lib7842/api/purePursuit/pathFollowerX.hpp"
@@ -44,10 +54,13 @@
 
 #include "lib7842/api/trajectory/generator/generator.hpp"
 #include "lib7842/api/trajectory/generator/skidGenerator.hpp"
+#include "lib7842/api/trajectory/generator/trajectoryFile.hpp"
 #include "lib7842/api/trajectory/generator/xGenerator.hpp"
 #include "lib7842/api/trajectory/profile/limits.hpp"
 #include "lib7842/api/trajectory/profile/piecewise_trapezoidal.hpp"
 #include "lib7842/api/trajectory/profile/profile.hpp"
+#include "lib7842/api/trajectory/profile/s_curve.hpp"
+#include "lib7842/api/trajectory/profile/time_optimal.hpp"
 #include "lib7842/api/trajectory/profile/trapezoidal.hpp"
 
 #include "lib7842/api/vision/container.hpp"
@@ -0,0 +1,101 @@
+#pragma once
+#include <cmath>
+#include <compare>
+
+namespace lib7842::util {
+
+/**
+ * A Jet is a number which carries its first and second derivatives along with its value. Any
+ * function that is written generically over its number type can be called with a Jet, and the
+ * arithmetic propagates the derivatives through every step using the product and chain rules. The
+ * result contains the value and both derivatives of the function, all calculated in a single pass
+ * that shares the intermediate terms. https://en.wikipedia.org/wiki/Automatic_differentiation
+ *
+ * The math functions are found through argument-dependent lookup, so generic code should call them
+ * unqualified after `using std::sin;` and so on, which lets the same code work with a double.
+ */
+struct Jet {
+  double v {0.0}; // the value
+  double d {0.0}; // the first derivative
+  double d2 {0.0}; // the second derivative
+
+  constexpr Jet() = default;
+  constexpr Jet(double iv, double id = 0.0, double id2 = 0.0) : v(iv), d(id), d2(id2) {}
+
+  /**
+   * Create a Jet for the variable of differentiation, whose derivative with respect to itself is 1.
+   *
+   * @param  x The value of the variable.
+   * @return The Jet.
+   */
+  static constexpr Jet variable(double x) { return {x, 1.0, 0.0}; }
+
+  constexpr Jet operator-() const { return {-v, -d, -d2}; }
+  constexpr Jet& operator+=(const Jet& rhs) { return *this = *this + rhs; }
+  constexpr Jet& operator-=(const Jet& rhs) { return *this = *this - rhs; }
+  constexpr Jet& operator*=(const Jet& rhs) { return *this = *this * rhs; }
+  constexpr Jet& operator/=(const Jet& rhs) { return *this = *this / rhs; }
+
+  friend constexpr Jet operator+(const Jet& a, const Jet& b) {
+    return {a.v + b.v, a.d + b.d, a.d2 + b.d2};
+  }
+  friend constexpr Jet operator-(const Jet& a, const Jet& b) {
+    return {a.v - b.v, a.d - b.d, a.d2 - b.d2};
+  }
+  friend constexpr Jet operator*(const Jet& a, const Jet& b) {
+    return {a.v * b.v, a.d * b.v + a.v * b.d, a.d2 * b.v + 2.0 * a.d * b.d + a.v * b.d2};
+  }
+  friend constexpr Jet operator/(const Jet& a, const Jet& b) {
+    double v = a.v / b.v;
+    double d = (a.d - v * b.d) / b.v;
+    return {v, d, (a.d2 - 2.0 * d * b.d - v * b.d2) / b.v};
+  }
+
+  // comparisons only look at the value, so that functions can branch on their input
+  friend constexpr bool operator==(const Jet& a, const Jet& b) { return a.v == b.v; }
+  friend constexpr auto operator<=>(const Jet& a, const Jet& b) { return a.v <=> b.v; }
+
+  /**
+   * Apply a function to a Jet using the chain rule, given the value of the function and its first
+   * two derivatives at the value of the Jet.
+   */
+  friend constexpr Jet chain(const Jet& a, double f, double f_d, double f_d2) {
+    return {f, f_d * a.d, f_d2 * a.d * a.d + f_d * a.d2};
+  }
+
+  friend constexpr Jet sin(const Jet& a) {
+    double s = std::sin(a.v);
+    return chain(a, s, std::cos(a.v), -s);
+  }
+  friend constexpr Jet cos(const Jet& a) {
+    double c = std::cos(a.v);
+    return chain(a, c, -std::sin(a.v), -c);
+  }
+  friend constexpr Jet tan(const Jet& a) {
+    double t = std::tan(a.v);
+    double sec2 = 1.0 + t * t;
+    return chain(a, t, sec2, 2.0 * t * sec2);
+  }
+  friend constexpr Jet atan(const Jet& a) {
+    double r = 1.0 / (1.0 + a.v * a.v);
+    return chain(a, std::atan(a.v), r, -2.0 * a.v * r * r);
+  }
+  friend constexpr Jet exp(const Jet& a) {
+    double e = std::exp(a.v);
+    return chain(a, e, e, e);
+  }
+  friend constexpr Jet log(const Jet& a) {
+    return chain(a, std::log(a.v), 1.0 / a.v, -1.0 / (a.v * a.v));
+  }
+  friend constexpr Jet sqrt(const Jet& a) {
+    double s = std::sqrt(a.v);
+    return chain(a, s, 0.5 / s, -0.25 / (s * a.v));
+  }
+  friend constexpr Jet pow(const Jet& a, double n) {
+    return chain(a, std::pow(a.v, n), n * std::pow(a.v, n - 1.0),
+                 n * (n - 1.0) * std::pow(a.v, n - 2.0));
+  }
+  friend constexpr Jet abs(const Jet& a) { return a.v < 0.0 ? -a : a; }
+};
+
+} // namespace lib7842::util
@@ -0,0 +1,76 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace lib7842::util {
+
+/**
+ * A Memo lazily caches the result of an expensive calculation, so that it is only calculated the
+ * first time it is needed. The result is stored along with a key, such as the resolution used to
+ * calculate it, and is only reused when the same key is asked for again.
+ *
+ * The memo is safe to share between tasks without a lock. The slot is filled at most once: the
+ * first caller to claim it calculates and publishes the result, and any other caller that arrives
+ * while it is being filled, or that asks for a different key, calculates the result itself without
+ * storing it. Once the slot is published it never changes, so readers can't see a partial result.
+ *
+ * A copy of a memo starts empty, since the object it belongs to may be modified after it is
+ * copied. During constant evaluation the memo is bypassed.
+ *
+ * @tparam K The type of the key.
+ * @tparam V The type of the cached value.
+ */
+template <class K, class V> class Memo {
+public:
+  constexpr Memo() = default;
+  constexpr Memo(const Memo& /*rhs*/) {}
+  constexpr Memo& operator=(const Memo& /*rhs*/) {
+    clear();
+    return *this;
+  }
+
+  /**
+   * Get the cached value for a key, or calculate it.
+   *
+   * @param  ikey The key the value was calculated with.
+   * @param  f    The function which calculates the value.
+   * @return The value.
+   */
+  template <class F> constexpr V get(const K& ikey, const F& f) const {
+    if (std::is_constant_evaluated()) { return f(); }
+
+    if (state.load(std::memory_order_acquire) == ready) {
+      return key == ikey ? value : f();
+    }
+
+    uint8_t expected = empty;
+    if (!state.compare_exchange_strong(expected, filling, std::memory_order_acquire)) {
+      return f();
+    }
+    key = ikey;
+    value = f();
+    state.store(ready, std::memory_order_release);
+    return value;
+  }
+
+  /**
+   * Empty the memo so that the value is calculated again. This must not be called while another
+   * task is using the memo.
+   */
+  constexpr void clear() {
+    if (std::is_constant_evaluated()) { return; }
+    state.store(empty, std::memory_order_relaxed);
+  }
+
+protected:
+  static constexpr uint8_t empty = 0;
+  static constexpr uint8_t filling = 1;
+  static constexpr uint8_t ready = 2;
+
+  mutable std::atomic<uint8_t> state {empty};
+  mutable K key {};
+  mutable V value {};
+};
+
+} // namespace lib7842::util
@@ -0,0 +1,57 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace lib7842::util {
+
+/**
+ * Integrate a function over an interval using the five-point Gauss–Legendre rule. The rule is
+ * exact for polynomials up to the ninth degree, so smooth functions only need a few evaluations.
+ * https://en.wikipedia.org/wiki/Gaussian_quadrature
+ *
+ * @param  f The function to integrate, which maps a double to a double.
+ * @param  a The start of the interval.
+ * @param  b The end of the interval.
+ * @return The integral of f from a to b.
+ */
+template <class F> constexpr double gauss_legendre(const F& f, double a, double b) {
+  constexpr std::array<double, 3> nodes {0.0, 0.5384693101056831, 0.9061798459386640};
+  constexpr std::array<double, 3> weights {0.5688888888888889, 0.4786286704993665,
+                                           0.2369268850561891};
+  double h = (b - a) / 2.0;
+  double c = (a + b) / 2.0;
+  double sum = weights[0] * f(c);
+  for (size_t i = 1; i < nodes.size(); ++i) {
+    sum += weights[i] * (f(c - h * nodes[i]) + f(c + h * nodes[i]));
+  }
+  return sum * h;
+}
+
+/**
+ * Integrate a function over an interval using adaptive Gauss–Legendre quadrature. The interval is
+ * recursively bisected until the estimate of each half agrees with the estimate of the whole to
+ * within the tolerance, which is split between the halves as the recursion deepens.
+ *
+ * @param  f         The function to integrate, which maps a double to a double.
+ * @param  a         The start of the interval.
+ * @param  b         The end of the interval.
+ * @param  tolerance The maximum absolute error of the result.
+ * @param  depth     The maximum number of times the interval can be bisected.
+ * @return The integral of f from a to b.
+ */
+template <class F>
+constexpr double integrate(const F& f, double a, double b, double tolerance, size_t depth = 10) {
+  auto step = [&](auto&& self, double start, double end, double whole, double tol,
+                  size_t remaining) -> double {
+    double mid = (start + end) / 2.0;
+    double left = gauss_legendre(f, start, mid);
+    double right = gauss_legendre(f, mid, end);
+    if (remaining == 0 || std::abs(left + right - whole) <= tol) { return left + right; }
+    return self(self, start, mid, left, tol / 2.0, remaining - 1) +
+           self(self, mid, end, right, tol / 2.0, remaining - 1);
+  };
+  return step(step, a, b, gauss_legendre(f, a, b), tolerance, depth);
+}
+
+} // namespace lib7842::util
@@ -5,6 +5,7 @@
 #include "okapi/api/units/QAngle.hpp"
 #include "piecewise.hpp"
 #include "spline.hpp"
+#include <tuple>
 
 namespace lib7842 {
 
@@ -12,7 +13,7 @@ namespace lib7842 {
  * This class describes a arc which connects two points together while taking the average of the
  * angles.
  */
-class Arc : public SplineHelper<Arc> {
+class Arc final : public SplineHelper<Arc> {
 public:
   constexpr Arc(const State& istart, const State& iend) : start(istart), end(iend) {
     theta = util::rollAngle180(iend.theta - istart.theta);
@@ -27,11 +28,15 @@ public:
     }
 
     rotate = start.angleTo(end) - theta / 2.0;
+    cos_r = cos(rotate - 90_deg).convert(number);
+    sin_r = sin(rotate - 90_deg).convert(number);
   }
 
   constexpr explicit Arc(const State& iend) : Arc({0_m, 0_m, 0_deg}, iend) {}
   constexpr Arc(const QAngle& istart, const State& iend) : Arc({0_m, 0_m, istart}, iend) {}
 
+  constexpr ~Arc() override {}
+
   constexpr State calc(double t) const override {
     QLength x = 0_m;
     QLength y = 0_m;
@@ -41,15 +46,7 @@ public:
       x = r.value() * cos(t * theta) - r.value();
       y = r.value() * sin(t * theta);
     }
-
-    QAngle new_theta = rotate - 90_deg;
-    QLength x_r = x * cos(new_theta) - y * sin(new_theta);
-    QLength y_r = y * cos(new_theta) + x * sin(new_theta);
-
-    x_r += start.x;
-    y_r += start.y;
-
-    return {x_r, y_r, rotate + theta * t};
+    return {start + rotated(x, y), rotate + theta * t};
   }
 
   constexpr QCurvature curvature(double /*t*/) const override {
@@ -58,37 +55,68 @@ public:
   }
 
   constexpr QLength length(double /*resolution*/ = 0) const override { return s; }
-
-  constexpr Vector calc_d(double t) const {
-    QLength x = 0_m;
-    QLength y = 0_m;
-    if (!r) {
-      y = s;
-    } else {
-      x = r.value() * theta / radian * -sin(t * theta);
-      y = r.value() * theta / radian * cos(t * theta);
+  constexpr QLength arc_length(const QLength& /*tolerance*/ = 0_m) const override { return s; }
+
+  /**
+   * Sample many points along the arc, which leaves a sine and cosine of the swept angle for every
+   * t.
+   */
+  constexpr void calc_batch(std::span<const double> ts, std::span<State> out) const override {
+    check_batch(ts.size(), out.size());
+    for (size_t i = 0; i < ts.size(); ++i) {
+      QLength x = 0_m;
+      QLength y = 0_m;
+      if (!r) {
+        y = s * ts[i];
+      } else {
+        x = r.value() * cos(ts[i] * theta) - r.value();
+        y = r.value() * sin(ts[i] * theta);
+      }
+      out[i] = {start + rotated(x, y), rotate + theta * ts[i]};
     }
+  }
 
-    QAngle new_theta = rotate - 90_deg;
-    QLength x_r = x * cos(new_theta) - y * sin(new_theta);
-    QLength y_r = y * cos(new_theta) + x * sin(new_theta);
+  constexpr void curvature_batch(std::span<const double> ts,
+                                 std::span<QCurvature> out) const override {
+    check_batch(ts.size(), out.size());
+    std::fill_n(out.begin(), ts.size(), curvature(0));
+  }
 
-    return {x_r, y_r};
+  constexpr void velocity_batch(std::span<const double> ts,
+                                std::span<QLength> out) const override {
+    check_batch(ts.size(), out.size());
+    std::fill_n(out.begin(), ts.size(), s);
   }
 
-  constexpr Vector calc_d2(double t) const {
-    QLength x = 0_m;
-    QLength y = 0_m;
-    if (r) {
-      x = r.value() * square(theta / radian) * -cos(t * theta);
-      y = r.value() * square(theta / radian) * -sin(t * theta);
-    }
+  constexpr Vector calc_d(double t) const override {
+    if (!r) { return rotated(0_m, s); }
+    QLength v = r.value() * theta / radian;
+    return rotated(v * -sin(t * theta), v * cos(t * theta));
+  }
 
-    QAngle new_theta = rotate - 90_deg;
-    QLength x_r = x * cos(new_theta) - y * sin(new_theta);
-    QLength y_r = y * cos(new_theta) + x * sin(new_theta);
+  constexpr Vector calc_d2(double t) const override {
+    if (!r) { return {}; }
+    QLength a = r.value() * square(theta / radian);
+    return rotated(a * -cos(t * theta), a * -sin(t * theta));
+  }
 
-    return {x_r, y_r};
+  /**
+   * Sample the point and both derivatives of the arc at t, sharing one sine and cosine of the
+   * swept angle between them.
+   *
+   * @param  t Where along the arc to sample, in the range of [0, 1].
+   * @return The point, first derivative, and second derivative at t.
+   */
+  constexpr std::tuple<State, Vector, Vector> calc_all(double t) const {
+    QAngle heading = rotate + theta * t;
+    if (!r) { return {{start + rotated(0_m, s * t), heading}, rotated(0_m, s), {}}; }
+    double cos_t = cos(t * theta).convert(number);
+    double sin_t = sin(t * theta).convert(number);
+    QLength v = r.value() * theta / radian;
+    QLength a = v * theta / radian;
+    return {{start + rotated(r.value() * (cos_t - 1), r.value() * sin_t), heading},
+            rotated(v * -sin_t, v * cos_t),
+            rotated(a * -cos_t, a * -sin_t)};
   }
 
 protected:
@@ -99,6 +127,15 @@ protected:
   std::optional<QLength> r; // the arc radius
   QLength s; // the arc length
   QAngle rotate; // how much the arc should be rotated
+  double cos_r {1.0}; // the rotation of the arc into place, found once
+  double sin_r {0.0};
+
+  /**
+   * Rotate a vector from the frame of the arc into place.
+   */
+  constexpr Vector rotated(const QLength& x, const QLength& y) const {
+    return {x * cos_r - y * sin_r, y * cos_r + x * sin_r};
+  }
 };
 
 /**
@@ -1,14 +1,15 @@
 #pragma once
 #include "parametric.hpp"
 #include "piecewise.hpp"
+#include "polynomial.hpp"
 #include "spline.hpp"
 
 namespace lib7842 {
 
 // forward declaration
-template <size_t N> class BezierFnc;
+template <size_t N, class S = double> class BezierFnc;
 // aliases
-template <size_t N> using Bezier = Parametric<BezierFnc<N>>;
+template <size_t N, class S = double> using Bezier = Parametric<BezierFnc<N, S>>;
 using CubicBezier = Bezier<3>;
 using QuarticBezier = Bezier<4>;
 using QuinticBezier = Bezier<5>;
@@ -17,81 +18,54 @@ using QuinticBezier = Bezier<5>;
  * A BezierFnc is a one-dimensional function that uses N+1 control points to produce a function of N
  * order. The spline begins at the first control point, ends at the last, but does not pass through
  * any middle points. The tangent of the start and end points are equal to the angle to their
- * nearest respective points. The bezier function is calculated using a generic implementation that
- * works with a bezier of any order using the recursive notation of the binomial coefficient.
- * However, this is quite inefficient, so template specialization is required for good performance.
- * https://en.wikipedia.org/wiki/B%C3%A9zier_curve
+ * nearest respective points. https://en.wikipedia.org/wiki/B%C3%A9zier_curve
+ *
+ * Rather than summing the Bernstein basis of every control point each time it is sampled, the
+ * control points are converted into the coefficients of x^i when the function is created. The
+ * function and its derivatives are then sampled by the PolynomialFnc using Horner's method.
+ * https://en.wikipedia.org/wiki/B%C3%A9zier_curve#Polynomial_form
  *
  * This class is designed to be used with the Parametric class to produce a two-dimensional spline.
  * Bezier<N> is an alias for Parametric<BezierFnc<N>>. There are also aliases for CubicBezier,
- * QuarticBezier, and QuinticBezier.
+ * QuarticBezier, and QuinticBezier. A Bezier<N, float> is evaluated in single precision.
  *
  * @tparam N The order of the BezierFnc.
+ * @tparam S The scalar type used to evaluate the function, see PolynomialFnc.
  */
-template <size_t N> class BezierFnc : public ParametricFnc {
+template <size_t N, class S> class BezierFnc : public PolynomialFnc<N, S> {
 public:
   /**
    * Create a new one-dimensional BezierFnc<N> given an array of N+1 control points.
    *
    * @param ictrls The control points.
    */
-  constexpr explicit BezierFnc(const std::array<double, N + 1>& ictrls) : ctrls(ictrls) {}
+  constexpr explicit BezierFnc(const std::array<double, N + 1>& ictrls) :
+    PolynomialFnc<N, S>(power(ictrls)), ctrls(ictrls) {}
 
-  /**
-   * Calculate the y value of the bezier given x.
-   * https://en.wikipedia.org/wiki/B%C3%A9zier_curve#Terminology
-   *
-   * @param  x The input value in the range of [0, 1].
-   * @return The calculated y value.
-   */
-  constexpr double calc(double x) const override {
-    double sum {0.0};
-    for (size_t i = 0; i < ctrls.size(); ++i) {
-      sum += basis(N, i, x) * ctrls[i];
-    }
-    return sum;
-  }
+  constexpr ~BezierFnc() override {}
 
   /**
-   * Calculate the first derivative of the bezier given x.
-   * https://en.wikipedia.org/wiki/B%C3%A9zier_curve#Derivative
-   *
-   * @param  x The input value in the range of [0, 1].
-   * @return The calculated first derivative.
+   * The control points the function was created with.
    */
-  constexpr double calc_d(double x) const override {
-    double sum {0.0};
-    for (size_t i = 0; i < N; ++i) {
-      sum += basis(N - 1, i, x) * N * (ctrls[i + 1] - ctrls[i]);
-    }
-    return sum;
-  }
-
-  /**
-   * Calculate the second derivative of the bezier given x.
-   *
-   * @param  x The input value in the range of [0, 1].
-   * @return The calculated second derivative.
-   */
-  constexpr double calc_d2(double x) const override {
-    double sum {0.0};
-    for (size_t i = 0; i < N - 1; ++i) {
-      sum += basis(N - 2, i, x) * N * (N - 1) * (ctrls[i + 2] - 2 * ctrls[i + 1] + ctrls[i]);
-    }
-
-    return sum;
-  }
-
-  static constexpr size_t order = N;
+  constexpr const std::array<double, N + 1>& controls() const { return ctrls; }
 
 protected:
   std::array<double, N + 1> ctrls {};
 
   /**
-   * The bezier basis function.
+   * Convert the control points into the coefficients of x^i.
+   * https://en.wikipedia.org/wiki/B%C3%A9zier_curve#Polynomial_form
    */
-  static constexpr double basis(size_t n, size_t k, double x) {
-    return comb(n, k) * std::pow(1.0 - x, n - k) * std::pow(x, k);
+  static constexpr std::array<double, N + 1> power(const std::array<double, N + 1>& ictrls) {
+    std::array<double, N + 1> coeffs {};
+    for (size_t j = 0; j <= N; ++j) {
+      double sum {0.0};
+      for (size_t i = 0; i <= j; ++i) {
+        sum += ((j - i) % 2 == 0 ? 1.0 : -1.0) * comb(j, i) * ictrls[i];
+      }
+      coeffs[j] = comb(N, j) * sum;
+    }
+    return coeffs;
   }
 
   /**
@@ -101,15 +75,11 @@ protected:
   static constexpr size_t comb(size_t n, size_t k) {
     if (k > n) { return 0; }
     if (k > n - k) { k = n - k; }
-    if (k == 0 or n <= 1) { return 1; }
-    return factorial(n) / (factorial(k) * factorial(n - k));
-  }
-
-  /**
-   * Naive factorial implementation.
-   */
-  static constexpr size_t factorial(size_t n) {
-    return (n == 1 || n == 0) ? 1 : factorial(n - 1) * n;
+    size_t result {1};
+    for (size_t i = 1; i <= k; ++i) {
+      result = result * (n - k + i) / i;
+    }
+    return result;
   }
 };
 
@@ -120,7 +90,8 @@ template <size_t N> BezierFnc(const std::array<double, N>&) -> BezierFnc<N - 1>;
  * Specialization for a Parametric<BezierFnc<N>> which allows construction using an array of 2D
  * control points.
  */
-template <size_t N> class Parametric<BezierFnc<N>> : public Parametric<BezierFnc<N>, true> {
+template <size_t N, class S>
+class Parametric<BezierFnc<N, S>> final : public Parametric<BezierFnc<N, S>, true> {
 public:
   /**
    * Helper method to construct a Piecewise<BezierFnc<N>> given an array of 2D control points.
@@ -130,15 +101,74 @@ public:
    * @param ctrls The array of control points.
    */
   constexpr explicit Parametric(const Vector (&ctrls)[N + 1]) :
-    Parametric<BezierFnc<N>, true>(
-      BezierFnc(process(ctrls, [](const auto& ip) { return ip.x.convert(meter); })),
-      BezierFnc(process(ctrls, [](const auto& ip) { return ip.y.convert(meter); }))) {}
+    Parametric<BezierFnc<N, S>, true>(
+      BezierFnc<N, S>(process(ctrls, [](const auto& ip) { return ip.x.convert(meter); })),
+      BezierFnc<N, S>(process(ctrls, [](const auto& ip) { return ip.y.convert(meter); }))) {}
+
+  /**
+   * Construct a Bezier given an array of 2D control points, such as the result of split.
+   *
+   * @param ctrls The array of control points.
+   */
+  constexpr explicit Parametric(const std::array<Vector, N + 1>& ctrls) :
+    Parametric<BezierFnc<N, S>, true>(
+      BezierFnc<N, S>(process(ctrls, [](const auto& ip) { return ip.x.convert(meter); })),
+      BezierFnc<N, S>(process(ctrls, [](const auto& ip) { return ip.y.convert(meter); }))) {}
+
+  constexpr ~Parametric() override {}
+
+  /**
+   * The 2D control points the Bezier was created with.
+   */
+  constexpr std::array<Vector, N + 1> controls() const {
+    std::array<Vector, N + 1> ctrls;
+    for (size_t i = 0; i <= N; ++i) {
+      ctrls[i] = {this->p.first.controls()[i] * meter, this->p.second.controls()[i] * meter};
+    }
+    return ctrls;
+  }
+
+  /**
+   * Split the Bezier at t into two Beziers of the same order, which together trace the same curve.
+   * The first covers [0, t] and the second covers [t, 1].
+   *
+   * @param  t Where to split the Bezier, in the range of [0, 1].
+   * @return The two halves.
+   */
+  constexpr std::pair<Parametric, Parametric> split(double t) const {
+    auto [left, right] = subdivide(controls(), t);
+    return {Parametric(left), Parametric(right)};
+  }
+
+  /**
+   * Split an array of control points at t using de Casteljau's algorithm. Each round interpolates
+   * between neighbouring points, and the first and last point of every round are the control points
+   * of the left and right halves. https://en.wikipedia.org/wiki/De_Casteljau%27s_algorithm
+   *
+   * @param  ctrls The control points of the Bezier.
+   * @param  t     Where to split the Bezier, in the range of [0, 1].
+   * @return The control points of the two halves.
+   */
+  static constexpr std::pair<std::array<Vector, N + 1>, std::array<Vector, N + 1>>
+    subdivide(const std::array<Vector, N + 1>& ctrls, double t) {
+    std::array<Vector, N + 1> left;
+    std::array<Vector, N + 1> right;
+    std::array<Vector, N + 1> work = ctrls;
+    for (size_t r = 0; r <= N; ++r) {
+      left[r] = work[0];
+      right[N - r] = work[N - r];
+      for (size_t i = 0; i < N - r; ++i) {
+        work[i] = work[i] * (1.0 - t) + work[i + 1] * t;
+      }
+    }
+    return {left, right};
+  }
 
 private:
   /**
    * Helper method to transform an array of 2D Vector into an array of 1D control points.
    */
-  constexpr auto process(const Vector (&ctrls)[N + 1], auto&& f) {
+  static constexpr auto process(const auto& ctrls, auto&& f) {
     std::array<double, N + 1> t;
     std::transform(std::begin(ctrls), std::end(ctrls), std::begin(t), f);
     return t;
@@ -156,7 +186,7 @@ template <size_t N> Parametric(const Vector (&)[N]) -> Parametric<BezierFnc<N -
  * @return A Piecewise<P, N>>.
  */
 template <class P, size_t N>
-requires std::same_as<P, Bezier<P::type::order>>
+requires std::same_as<P, Bezier<P::type::order, typename P::type::scalar>>
 constexpr auto make_piecewise(const Vector (&ctrls)[N][P::type::order + 1]) {
   std::array<std::optional<P>, N> p;
   for (size_t i = 0; i < N; ++i) {
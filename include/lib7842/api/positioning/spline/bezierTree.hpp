@@ -0,0 +1,335 @@
+#pragma once
+#include "bezier.hpp"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace lib7842 {
+
+/**
+ * An axis-aligned box, such as an obstacle on the field, given by its bottom left and top right
+ * corners.
+ */
+struct Box {
+  Vector min;
+  Vector max;
+};
+
+/**
+ * A BezierTree is a bounding volume hierarchy over a Bezier, or a Piecewise of Beziers, which is
+ * used to answer geometric questions about the path without sampling it. A Bezier always lies
+ * within the convex hull of its control points, so the box around the control points is a cheap
+ * bound of the curve. Splitting the Bezier in half with de Casteljau's algorithm produces two
+ * smaller curves with tighter boxes, and the tree is made by repeatedly splitting.
+ *
+ * The tree is built lazily. Each query only splits the nodes whose boxes it can't rule out, and
+ * the halves are kept for later queries. Once the control points of a node are within the
+ * tolerance of the line between its ends, the node is treated as that line, so each answer is
+ * exact to within the tolerance.
+ *
+ * The tree keeps its own copy of the control points, so it does not depend on the lifetime of the
+ * spline it was built from. Queries split nodes and so modify the tree, which is why they are not
+ * const. A tree must not be shared between tasks without a lock.
+ *
+ * @tparam N The order of the Beziers.
+ */
+template <size_t N> class BezierTree {
+public:
+  /**
+   * Create a new BezierTree over a Bezier.
+   *
+   * @param ibezier    The Bezier.
+   * @param itolerance The distance from the curve that the answers are exact to.
+   */
+  explicit BezierTree(const Bezier<N>& ibezier, const QLength& itolerance = 1_mm) :
+    tolerance(itolerance) {
+    add(ibezier.controls());
+  }
+
+  /**
+   * Create a new BezierTree over a Piecewise of Beziers. Each Bezier is the root of its own tree.
+   *
+   * @param ipiecewise The Piecewise of Beziers, either fixed or dynamic.
+   * @param itolerance The distance from the curve that the answers are exact to.
+   */
+  template <size_t M>
+  explicit BezierTree(const Piecewise<Bezier<N>, M>& ipiecewise,
+                      const QLength& itolerance = 1_mm) :
+    tolerance(itolerance) {
+    for (size_t i = 0; i < ipiecewise.size(); ++i) {
+      add(ipiecewise.segment(i).controls());
+    }
+  }
+
+  /**
+   * Find the box which contains the entire path.
+   */
+  Box bounds() const {
+    Box box = nodes[0].box;
+    for (size_t i = 1; i < roots; ++i) {
+      box = merge(box, nodes[i].box);
+    }
+    return box;
+  }
+
+  /**
+   * Find the shortest distance between the path and a point. Nodes are visited closest first, and
+   * any node whose box is further away than the closest distance found so far is skipped.
+   *
+   * @param  ipoint The point.
+   * @return The distance to the closest point on the path.
+   */
+  QLength distance(const Vector& ipoint) {
+    QLength best = std::numeric_limits<double>::infinity() * meter;
+    std::vector<size_t> stack(roots);
+    std::iota(stack.rbegin(), stack.rend(), 0);
+    while (!stack.empty()) {
+      size_t i = stack.back();
+      stack.pop_back();
+      if (distance(nodes[i].box, ipoint) >= best) { continue; }
+      if (nodes[i].flat) {
+        best = std::min(best, distance(chord(i), ipoint));
+        continue;
+      }
+      size_t c = split(i);
+      // push the further child first so that the closer one is visited next
+      bool swap = distance(nodes[c].box, ipoint) < distance(nodes[c + 1].box, ipoint);
+      stack.push_back(swap ? c + 1 : c);
+      stack.push_back(swap ? c : c + 1);
+    }
+    return best;
+  }
+
+  /**
+   * Check whether the path passes through a rectangular obstacle.
+   *
+   * @param  ibox The obstacle.
+   * @return Whether the path intersects the obstacle.
+   */
+  bool intersects(const Box& ibox) {
+    return search([&](size_t i) { return overlaps(nodes[i].box, ibox); },
+                  [&](size_t i) { return intersects(chord(i), ibox); });
+  }
+
+  /**
+   * Check whether the path passes within a distance of a point, such as a round obstacle.
+   *
+   * @param  icenter The center of the obstacle.
+   * @param  iradius The radius of the obstacle.
+   * @return Whether the path intersects the obstacle.
+   */
+  bool intersects(const Vector& icenter, const QLength& iradius) {
+    return search([&](size_t i) { return distance(nodes[i].box, icenter) <= iradius; },
+                  [&](size_t i) { return distance(chord(i), icenter) <= iradius; });
+  }
+
+  /**
+   * Check whether two paths cross or touch each other. Pairs of nodes whose boxes overlap are
+   * split, always splitting the larger of the two, until both are flat and their lines can be
+   * tested. Both trees are split as needed.
+   *
+   * @param  other The tree of the other path.
+   * @return Whether the paths intersect.
+   */
+  template <size_t M> bool intersects(BezierTree<M>& other) {
+    std::vector<std::pair<size_t, size_t>> stack;
+    for (size_t i = 0; i < roots; ++i) {
+      for (size_t j = 0; j < other.roots; ++j) {
+        stack.emplace_back(i, j);
+      }
+    }
+    while (!stack.empty()) {
+      auto [i, j] = stack.back();
+      stack.pop_back();
+      if (!overlaps(nodes[i].box, other.nodes[j].box)) { continue; }
+      bool flat_i = nodes[i].flat;
+      bool flat_j = other.nodes[j].flat;
+      if (flat_i && flat_j) {
+        if (intersects(chord(i), other.chord(j))) { return true; }
+      } else if (flat_j || (!flat_i && size(nodes[i].box) >= size(other.nodes[j].box))) {
+        size_t c = split(i);
+        stack.emplace_back(c, j);
+        stack.emplace_back(c + 1, j);
+      } else {
+        size_t c = other.split(j);
+        stack.emplace_back(i, c);
+        stack.emplace_back(i, c + 1);
+      }
+    }
+    return false;
+  }
+  template <size_t M> bool intersects(BezierTree<M>&& other) { return intersects(other); }
+
+protected:
+  template <size_t> friend class BezierTree;
+
+  struct Node {
+    std::array<Vector, N + 1> ctrls;
+    Box box;
+    size_t depth {0};
+    size_t children {0}; // the index of the first child, or zero if the node has not been split
+    bool flat {false};
+  };
+
+  // the depth at which a node is treated as flat, even if it isn't within the tolerance
+  static constexpr size_t max_depth = 24;
+
+  QLength tolerance;
+  size_t roots {0};
+  std::vector<Node> nodes;
+
+  /**
+   * Add a root node for a Bezier.
+   */
+  void add(const std::array<Vector, N + 1>& ictrls) {
+    nodes.push_back(make(ictrls, 0));
+    ++roots;
+  }
+
+  /**
+   * Create a node given its control points, finding its box and whether it is flat.
+   */
+  Node make(const std::array<Vector, N + 1>& ictrls, size_t idepth) const {
+    Node node {ictrls, {ictrls[0], ictrls[0]}, idepth};
+    for (const auto& ctrl : ictrls) {
+      node.box = merge(node.box, {ctrl, ctrl});
+    }
+    std::pair line {ictrls[0], ictrls[N]};
+    node.flat = idepth >= max_depth || std::all_of(ictrls.begin(), ictrls.end(), [&](auto& ip) {
+                  return distance(line, ip) <= tolerance;
+                });
+    return node;
+  }
+
+  /**
+   * Split a node in half if it has not been split already.
+   *
+   * @return The index of the first child. The second child follows it.
+   */
+  size_t split(size_t i) {
+    if (nodes[i].children == 0) {
+      auto [left, right] = Bezier<N>::subdivide(nodes[i].ctrls, 0.5);
+      size_t depth = nodes[i].depth + 1;
+      nodes[i].children = nodes.size();
+      nodes.push_back(make(left, depth));
+      nodes.push_back(make(right, depth));
+    }
+    return nodes[i].children;
+  }
+
+  /**
+   * Search the tree for a flat node which satisfies a test, skipping any node whose box fails a
+   * broader test.
+   */
+  bool search(const auto& box_test, const auto& line_test) {
+    std::vector<size_t> stack(roots);
+    std::iota(stack.begin(), stack.end(), 0);
+    while (!stack.empty()) {
+      size_t i = stack.back();
+      stack.pop_back();
+      if (!box_test(i)) { continue; }
+      if (nodes[i].flat) {
+        if (line_test(i)) { return true; }
+        continue;
+      }
+      size_t c = split(i);
+      stack.push_back(c);
+      stack.push_back(c + 1);
+    }
+    return false;
+  }
+
+  /**
+   * The line between the ends of a node.
+   */
+  std::pair<Vector, Vector> chord(size_t i) const { return {nodes[i].ctrls[0], nodes[i].ctrls[N]}; }
+
+  static Box merge(const Box& a, const Box& b) {
+    return {{std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y)},
+            {std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y)}};
+  }
+
+  static bool overlaps(const Box& a, const Box& b) {
+    return a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y &&
+           b.min.y <= a.max.y;
+  }
+
+  static QLength size(const Box& box) {
+    return std::max(box.max.x - box.min.x, box.max.y - box.min.y);
+  }
+
+  /**
+   * The distance from a point to the closest point in a box, which is zero inside the box.
+   */
+  static QLength distance(const Box& box, const Vector& ip) {
+    QLength dx = std::max({box.min.x - ip.x, 0_m, ip.x - box.max.x});
+    QLength dy = std::max({box.min.y - ip.y, 0_m, ip.y - box.max.y});
+    return Vector(dx, dy).distTo({0_m, 0_m});
+  }
+
+  /**
+   * The distance from a point to the closest point on a line segment.
+   */
+  static QLength distance(const std::pair<Vector, Vector>& line, const Vector& ip) {
+    auto [a, b] = line;
+    double dx = (b.x - a.x).convert(meter);
+    double dy = (b.y - a.y).convert(meter);
+    double len2 = dx * dx + dy * dy;
+    double t {0.0};
+    if (len2 > 0.0) {
+      t = ((ip.x - a.x).convert(meter) * dx + (ip.y - a.y).convert(meter) * dy) / len2;
+      t = std::clamp(t, 0.0, 1.0);
+    }
+    return ip.distTo(a + (b - a) * t);
+  }
+
+  /**
+   * Check whether a line segment passes through a box by clipping the line to each pair of sides.
+   * https://en.wikipedia.org/wiki/Liang%E2%80%93Barsky_algorithm
+   */
+  static bool intersects(const std::pair<Vector, Vector>& line, const Box& box) {
+    auto [a, b] = line;
+    double lo {0.0};
+    double hi {1.0};
+    auto clip = [&](double start, double delta, double min, double max) {
+      if (delta == 0.0) { return start >= min && start <= max; }
+      double t0 = (min - start) / delta;
+      double t1 = (max - start) / delta;
+      if (t0 > t1) { std::swap(t0, t1); }
+      lo = std::max(lo, t0);
+      hi = std::min(hi, t1);
+      return lo <= hi;
+    };
+    return clip(a.x.convert(meter), (b.x - a.x).convert(meter), box.min.x.convert(meter),
+                box.max.x.convert(meter)) &&
+           clip(a.y.convert(meter), (b.y - a.y).convert(meter), box.min.y.convert(meter),
+                box.max.y.convert(meter));
+  }
+
+  /**
+   * Check whether two line segments cross or touch. Each segment must have its ends on opposite
+   * sides of the other, or one of the ends must lie on the other segment.
+   */
+  static bool intersects(const std::pair<Vector, Vector>& l1, const std::pair<Vector, Vector>& l2) {
+    auto cross = [](const Vector& o, const Vector& a, const Vector& b) {
+      return (a.x - o.x).convert(meter) * (b.y - o.y).convert(meter) -
+             (a.y - o.y).convert(meter) * (b.x - o.x).convert(meter);
+    };
+    auto on = [](const std::pair<Vector, Vector>& l, const Vector& ip) {
+      return std::min(l.first.x, l.second.x) <= ip.x && ip.x <= std::max(l.first.x, l.second.x) &&
+             std::min(l.first.y, l.second.y) <= ip.y && ip.y <= std::max(l.first.y, l.second.y);
+    };
+    double d1 = cross(l2.first, l2.second, l1.first);
+    double d2 = cross(l2.first, l2.second, l1.second);
+    double d3 = cross(l1.first, l1.second, l2.first);
+    double d4 = cross(l1.first, l1.second, l2.second);
+    if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) && ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0))) {
+      return true;
+    }
+    return (d1 == 0 && on(l2, l1.first)) || (d2 == 0 && on(l2, l1.second)) ||
+           (d3 == 0 && on(l1, l2.first)) || (d4 == 0 && on(l1, l2.second));
+  }
+};
+
+} // namespace lib7842
@@ -0,0 +1,184 @@
+#pragma once
+#include "parametric.hpp"
+#include "polynomial.hpp"
+#include "spline.hpp"
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace lib7842 {
+
+/**
+ * A BSpline is a uniform B-spline of degree D, which is a chain of polynomial spans that share
+ * their control points. Each span is shaped by only D+1 neighbouring control points, and spans meet
+ * with D-1 continuous derivatives, so a cubic BSpline has continuous curvature everywhere.
+ * https://en.wikipedia.org/wiki/B-spline
+ *
+ * Since the knots are uniform, every span is found by multiplying its control points by the same
+ * basis matrix, which gives the coefficients of x^i of the span. The coefficients are found when
+ * the spline is created, so sampling the spline is one division to find the span and one pass of
+ * Horner's method, no matter how many control points there are. This makes a BSpline suitable for
+ * long routes with hundreds of control points. Moving a control point only rebuilds the D+1 spans
+ * it touches.
+ *
+ * Like Piecewise<S, N>, `t` is spread equally across the spans. The spline does not pass through
+ * its first and last control points. To start and end on a point, repeat it D times.
+ *
+ * @tparam D The degree of the BSpline, either 3 or 5.
+ */
+template <size_t D>
+requires(D == 3 || D == 5)
+class BSpline final : public SplineHelper<BSpline<D>> {
+public:
+  /**
+   * Create a new BSpline given a list of control points. Must contain at least D+1 points.
+   *
+   * @param ictrls The control points.
+   */
+  explicit BSpline(std::vector<Vector> ictrls) : ctrls(std::move(ictrls)) {
+    if (ctrls.size() < D + 1) {
+      throw std::invalid_argument("BSpline: needs at least degree + 1 control points");
+    }
+    spans.reserve(ctrls.size() - D);
+    for (size_t i = 0; i < ctrls.size() - D; ++i) {
+      spans.push_back(make_span(i));
+    }
+  }
+
+  ~BSpline() override {}
+
+  /**
+   * Provides all the necessary Spline overrides. These work by mapping `t` to a span and the `t`
+   * within the span, and scaling the derivatives of the span by the number of spans.
+   *
+   * @param  t Where along the spline to sample, in the range of [0, 1].
+   * @return The sampled point at t.
+   */
+  State calc(double t) const override { return get(t, &Span::calc); }
+  QCurvature curvature(double t) const override { return get(t, &Span::curvature); }
+  QLength velocity(double t) const override { return get(t, &Span::velocity) * scale(); }
+  Vector calc_d(double t) const override { return get(t, &Span::calc_d) * scale(); }
+  Vector calc_d2(double t) const override { return get(t, &Span::calc_d2) * (scale() * scale()); }
+  Spline::Sample evaluate(double t) const override {
+    auto sample = get(t, &Span::evaluate);
+    sample.velocity *= scale();
+    return sample;
+  }
+  QLength length(double resolution) const override {
+    return std::accumulate(spans.begin(), spans.end(), 0_m, [&](const QLength& l, const Span& ip) {
+      return l + ip.cached_length(resolution);
+    });
+  }
+  QLength arc_length(const QLength& tolerance = 0.1_mm) const override {
+    return std::accumulate(spans.begin(), spans.end(), 0_m, [&](const QLength& l, const Span& ip) {
+      return l + ip.cached_arc_length(tolerance / spans.size());
+    });
+  }
+
+  /**
+   * Move a control point. Only the spans which use the point are rebuilt, so the lengths of the
+   * other spans stay cached.
+   *
+   * @param i      The index of the control point.
+   * @param ipoint The new position of the control point.
+   */
+  void set(size_t i, const Vector& ipoint) {
+    ctrls.at(i) = ipoint;
+    size_t first = i > D ? i - D : 0;
+    size_t last = std::min(i, spans.size() - 1);
+    for (size_t j = first; j <= last; ++j) {
+      spans[j] = make_span(j);
+    }
+    this->invalidate();
+  }
+
+  /**
+   * The control points of the spline, and the number of spans.
+   */
+  const std::vector<Vector>& controls() const { return ctrls; }
+  size_t size() const { return spans.size(); }
+
+protected:
+  using Span = Parametric<PolynomialFnc<D>>;
+
+  std::vector<Vector> ctrls;
+  std::vector<Span> spans;
+
+  /**
+   * The basis matrix of a uniform B-spline, where basis[i][j] is the coefficient of x^i for the
+   * j-th control point of a span. Found using the formula in "General matrix representations for
+   * B-splines" (Qin, 2000).
+   */
+  static constexpr std::array<std::array<double, D + 1>, D + 1> basis = [] {
+    auto comb = [](size_t n, size_t k) {
+      double c {1.0};
+      for (size_t i = 1; i <= k; ++i) {
+        c = c * (n - k + i) / i;
+      }
+      return c;
+    };
+    auto power = [](double x, size_t n) {
+      double p {1.0};
+      for (size_t i = 0; i < n; ++i) {
+        p *= x;
+      }
+      return p;
+    };
+    double factorial {1.0};
+    for (size_t i = 2; i <= D; ++i) {
+      factorial *= i;
+    }
+    std::array<std::array<double, D + 1>, D + 1> m {};
+    for (size_t i = 0; i <= D; ++i) {
+      for (size_t j = 0; j <= D; ++j) {
+        double sum {0.0};
+        for (size_t s = j; s <= D; ++s) {
+          sum += ((s - j) % 2 == 0 ? 1.0 : -1.0) * comb(D + 1, s - j) * power(D - s, D - i);
+        }
+        m[i][j] = comb(D, i) * sum / factorial;
+      }
+    }
+    return m;
+  }();
+
+  /**
+   * Find the coefficients of a span from its control points.
+   */
+  Span make_span(size_t i) const {
+    std::array<double, D + 1> x {};
+    std::array<double, D + 1> y {};
+    for (size_t k = 0; k <= D; ++k) {
+      for (size_t j = 0; j <= D; ++j) {
+        x[k] += basis[k][j] * ctrls[i + j].x.convert(meter);
+        y[k] += basis[k][j] * ctrls[i + j].y.convert(meter);
+      }
+    }
+    return Span(PolynomialFnc<D>(x), PolynomialFnc<D>(y));
+  }
+
+  /**
+   * The ratio between the change in t of a span and the change in t of the spline.
+   */
+  double scale() const { return static_cast<double>(spans.size()); }
+
+  /**
+   * Helper function to map the value of t to a span. This handles the knots of the spans by
+   * choosing the beginning of the next span over the end of the current span (unless the current
+   * span is the last one).
+   *
+   * @param  t Where along the spline to sample, in the range of [0, 1].
+   * @param  f What value to get from the span.
+   * @return The value sampled from one of the spans according to t and f.
+   */
+  auto get(double t, const auto& f) const {
+    double u = std::clamp(t, 0.0, 1.0) * spans.size();
+    size_t i = std::min(static_cast<size_t>(u), spans.size() - 1);
+    return std::invoke(f, spans[i], u - i);
+  }
+};
+
+// aliases
+using CubicBSpline = BSpline<3>;
+using QuinticBSpline = BSpline<5>;
+
+} // namespace lib7842
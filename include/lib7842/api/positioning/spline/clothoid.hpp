@@ -0,0 +1,99 @@
+#pragma once
+#include "lib7842/api/other/quadrature.hpp"
+#include "lib7842/api/other/units.hpp"
+#include "lib7842/api/positioning/point/state.hpp"
+#include "spline.hpp"
+
+namespace lib7842 {
+
+/**
+ * A Clothoid, also known as an Euler spiral, is a curve whose curvature changes linearly with the
+ * distance travelled along it. This makes it the natural way to ease between a straight line and an
+ * arc: the curvature, and so the difference between the wheel speeds, ramps smoothly instead of
+ * jumping. https://en.wikipedia.org/wiki/Euler_spiral
+ *
+ * Since the curve is defined by its length and curvature, the length, velocity, curvature, and
+ * heading are all exact closed forms. The position is a Fresnel integral, which has no closed form.
+ * The position at a number of evenly spaced knots is integrated when the clothoid is created, so
+ * each point only needs the integral from the nearest knot, which the five-point Gauss–Legendre
+ * rule finds to within about a micrometer, even for a spiral that turns through a full circle.
+ */
+class Clothoid final : public SplineHelper<Clothoid> {
+public:
+  /**
+   * Create a new Clothoid given its start state, the curvature at each end, and its length.
+   *
+   * @param istart   The start state.
+   * @param istart_k The curvature at the start. A positive curvature turns to the left.
+   * @param iend_k   The curvature at the end.
+   * @param ilength  The length of the clothoid. Must be greater than zero.
+   */
+  constexpr Clothoid(const State& istart, const QCurvature& istart_k, const QCurvature& iend_k,
+                     const QLength& ilength) :
+    theta(istart.theta.convert(radian)),
+    k0(istart_k.convert(1 / meter)),
+    dk(((iend_k - istart_k) / ilength).convert(1 / meter / meter)),
+    s(ilength.convert(meter)) {
+    s > 0 ? true : throw std::invalid_argument("Clothoid: length must be greater than zero");
+    knots[0] = istart.vector();
+    for (size_t i = 0; i < segments; ++i) {
+      knots[i + 1] = knots[i] + integrate(s * i / segments, s * (i + 1) / segments);
+    }
+  }
+
+  constexpr ~Clothoid() override {}
+
+  constexpr State calc(double t) const override {
+    t = std::clamp(t, 0.0, 1.0);
+    double dist = t * s;
+    size_t i = std::min(static_cast<size_t>(t * segments), segments - 1);
+    return {knots[i] + integrate(s * i / segments, dist), heading(dist) * radian};
+  }
+
+  /**
+   * The exact derivatives of the clothoid. The velocity is always the length, and the second
+   * derivative is perpendicular to the heading, with a magnitude of the curvature.
+   */
+  constexpr Vector calc_d(double t) const override {
+    double h = heading(t * s);
+    return Vector(std::cos(h) * meter, std::sin(h) * meter) * s;
+  }
+  constexpr Vector calc_d2(double t) const override {
+    double h = heading(t * s);
+    return Vector(-std::sin(h) * meter, std::cos(h) * meter) * (s * s * (k0 + dk * t * s));
+  }
+
+  constexpr QCurvature curvature(double t) const override { return (k0 + dk * t * s) / meter; }
+  constexpr QLength velocity(double /*t*/) const override { return s * meter; }
+  constexpr QLength length(double /*resolution*/ = 0) const override { return s * meter; }
+  constexpr QLength arc_length(const QLength& /*tolerance*/ = 0_m) const override {
+    return s * meter;
+  }
+
+protected:
+  static constexpr size_t segments = 16; // the number of knots between the start and end
+
+  double theta; // the start heading in radians
+  double k0; // the start curvature in 1/m
+  double dk; // the change in curvature per meter in 1/m^2
+  double s; // the length in meters
+  std::array<Vector, segments + 1> knots {}; // the position at each knot
+
+  /**
+   * The heading after travelling a distance along the clothoid, in radians.
+   */
+  constexpr double heading(double dist) const {
+    return theta + k0 * dist + dk * dist * dist / 2.0;
+  }
+
+  /**
+   * Integrate the direction of the clothoid between two distances, giving the change in position.
+   */
+  constexpr Vector integrate(double a, double b) const {
+    double x = util::gauss_legendre([&](double dist) { return std::cos(heading(dist)); }, a, b);
+    double y = util::gauss_legendre([&](double dist) { return std::sin(heading(dist)); }, a, b);
+    return {x * meter, y * meter};
+  }
+};
+
+} // namespace lib7842
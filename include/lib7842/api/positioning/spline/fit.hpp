@@ -0,0 +1,239 @@
+#pragma once
+#include "bezier.hpp"
+#include "hermite.hpp"
+#include <algorithm>
+#include <span>
+#include <vector>
+
+namespace lib7842 {
+
+/**
+ * A Fitter turns a long list of recorded states, such as the odometry of a driver demonstrating a
+ * route, into a compact Piecewise of CubicBezier or Hermite splines that passes within a tolerance
+ * of every point. It is an adaptation of Schneider's algorithm, "An Algorithm for Automatically
+ * Fitting Digitized Curves" (Graphics Gems, 1990).
+ *
+ * A segment is fit between two points with fixed headings at either end, so only the stretch of
+ * each end is unknown. The spline is linear in the stretches, so the stretches that minimize the
+ * squared distance to every point in between are found by solving a 2x2 system. If the fit is
+ * close, the `t` of each point is refined with Newton's method and the segment is fit again. If it
+ * is still too far, the segment is split at the point with the largest error, and each half is fit
+ * on its own. The heading at a split is shared by both halves, so the result is smooth.
+ *
+ * The headings are estimated from the points rather than taken from the states, since the heading
+ * of a robot isn't the direction of travel when it drives backwards or drifts. The direction at a
+ * point is measured to the nearest points which are at least the tolerance away, so the noise of
+ * the odometry does not affect it.
+ *
+ * @tparam P The type of spline to fit, either CubicBezier or a Hermite.
+ */
+template <class P>
+requires std::same_as<P, CubicBezier> || std::same_as<P, Hermite<P::type::order>>
+class Fitter {
+public:
+  /**
+   * Fit a Piecewise of splines to a list of states.
+   *
+   * @param  trace      The recorded states. Repeated points, such as when the robot was stopped,
+   *                    are ignored. Must contain at least two different points.
+   * @param  tolerance  The maximum distance between the piecewise and any of the points.
+   * @param  iterations The maximum number of times the `t` of each point is refined before a
+   *                    segment is split.
+   * @return A Piecewise<P, std::dynamic_extent>.
+   */
+  static auto fit(std::span<const State> trace, const QLength& tolerance, size_t iterations = 4) {
+    Fitter f(tolerance, iterations);
+    for (const auto& ip : trace) {
+      if (f.points.empty() || f.points.back().distTo(ip) > tolerance / 100) {
+        f.points.emplace_back(ip);
+      }
+    }
+    if (f.points.size() < 2) {
+      throw std::invalid_argument("Fitter::fit: needs at least two different points");
+    }
+    size_t last = f.points.size() - 1;
+    f.fit(0, last, f.direction(0, last), f.direction(last, 0) + 180_deg);
+    return make_piecewise(std::move(f.segments));
+  }
+
+protected:
+  // the hermite basis functions, which weigh the start, start tangent, end tangent, and end
+  static constexpr size_t order = P::type::order;
+  static constexpr HermiteFnc<order> h00 {1.0, 0.0, 0.0, 0.0};
+  static constexpr HermiteFnc<order> h10 {0.0, 1.0, 0.0, 0.0};
+  static constexpr HermiteFnc<order> h11 {0.0, 0.0, 0.0, 1.0};
+  static constexpr HermiteFnc<order> h01 {0.0, 0.0, 1.0, 0.0};
+
+  Fitter(const QLength& itolerance, size_t iiterations) :
+    tolerance(itolerance), iterations(iiterations) {}
+
+  QLength tolerance;
+  size_t iterations;
+  std::vector<Vector> points;
+  std::vector<P> segments;
+
+  /**
+   * Fit the points between first and last, splitting them until each segment is within the
+   * tolerance.
+   */
+  void fit(size_t first, size_t last, const QAngle& start, const QAngle& end) {
+    std::vector<double> u = parameterize(first, last);
+    for (size_t i = 0;; ++i) {
+      auto [start_s, end_s] = solve(first, last, u, start, end);
+      P segment = make({points[first], start}, {points[last], end}, start_s, end_s);
+      auto [error, worst] = max_error(segment, first, last, u);
+      if (error <= tolerance) {
+        segments.push_back(std::move(segment));
+        return;
+      }
+      if (error > tolerance * 4 || i == iterations) {
+        QAngle mid = points[reach(worst, first)].angleTo(points[reach(worst, last)]);
+        fit(first, worst, start, mid);
+        fit(worst, last, mid, end);
+        return;
+      }
+      reparameterize(segment, first, u);
+    }
+  }
+
+  /**
+   * Create a spline between two states with the given stretches.
+   */
+  static P make(const State& start, const State& end, double start_s, double end_s) {
+    if constexpr (std::same_as<P, CubicBezier>) {
+      // a cubic bezier is a cubic hermite with the inner control points at a third of the tangents
+      Vector start_t = Vector(cos(start.theta) * meter, sin(start.theta) * meter) * (start_s / 3);
+      Vector end_t = Vector(cos(end.theta) * meter, sin(end.theta) * meter) * (end_s / 3);
+      Vector a = start;
+      Vector b = end;
+      return P(std::array<Vector, 4> {a, a + start_t, b - end_t, b});
+    } else {
+      return P(start, end, start_s, end_s);
+    }
+  }
+
+  /**
+   * Assign each point a `t` in proportion to the distance along the points.
+   */
+  std::vector<double> parameterize(size_t first, size_t last) const {
+    std::vector<double> u(last - first + 1, 0.0);
+    for (size_t i = first + 1; i <= last; ++i) {
+      u[i - first] = u[i - first - 1] + points[i].distTo(points[i - 1]).convert(meter);
+    }
+    for (auto& iu : u) {
+      iu /= u.back();
+    }
+    return u;
+  }
+
+  /**
+   * Find the stretches which minimize the squared distance between the spline and the points, by
+   * solving the normal equations of the least squares problem. If the points don't determine the
+   * stretches, or they are found to point backwards, both are set to the distance between the ends.
+   */
+  std::pair<double, double> solve(size_t first, size_t last, const std::vector<double>& u,
+                                  const QAngle& start, const QAngle& end) const {
+    double c0 = cos(start).convert(number), s0 = sin(start).convert(number);
+    double c1 = cos(end).convert(number), s1 = sin(end).convert(number);
+    auto [x0, y0] = meters(points[first]);
+    auto [x1, y1] = meters(points[last]);
+
+    double a11 {0.0}, a12 {0.0}, a22 {0.0}, b1 {0.0}, b2 {0.0};
+    for (size_t i = first + 1; i < last; ++i) {
+      double t = u[i - first];
+      auto [x, y] = meters(points[i]);
+      double rx = x - x0 * h00.calc(t) - x1 * h01.calc(t);
+      double ry = y - y0 * h00.calc(t) - y1 * h01.calc(t);
+      double w1 = h10.calc(t);
+      double w2 = h11.calc(t);
+      // the tangents have unit length, so only the dot product between them remains
+      a11 += w1 * w1;
+      a12 += w1 * w2 * (c0 * c1 + s0 * s1);
+      a22 += w2 * w2;
+      b1 += w1 * (c0 * rx + s0 * ry);
+      b2 += w2 * (c1 * rx + s1 * ry);
+    }
+
+    double fallback = points[first].distTo(points[last]).convert(meter);
+    double det = a11 * a22 - a12 * a12;
+    if (std::abs(det) < 1e-12) { return {fallback, fallback}; }
+    double start_s = (b1 * a22 - b2 * a12) / det;
+    double end_s = (a11 * b2 - a12 * b1) / det;
+    if (start_s < 1e-6 * fallback || end_s < 1e-6 * fallback) { return {fallback, fallback}; }
+    return {start_s, end_s};
+  }
+
+  /**
+   * Find the largest distance between the spline and the points, and the point where it occurs.
+   */
+  std::pair<QLength, size_t> max_error(const P& segment, size_t first, size_t last,
+                                       const std::vector<double>& u) const {
+    QLength error {0_m};
+    size_t worst = (first + last) / 2;
+    for (size_t i = first + 1; i < last; ++i) {
+      QLength d = segment.calc(u[i - first]).distTo(points[i]);
+      if (d > error) {
+        error = d;
+        worst = i;
+      }
+    }
+    return {error, worst};
+  }
+
+  /**
+   * Move the `t` of each point towards the closest point on the spline using a step of Newton's
+   * method.
+   */
+  void reparameterize(const P& segment, size_t first, std::vector<double>& u) const {
+    for (size_t i = 1; i + 1 < u.size(); ++i) {
+      auto [px, py] = meters(segment.calc(u[i]));
+      auto [x, y] = meters(points[first + i]);
+      auto [dx, dy] = meters(segment.calc_d(u[i]));
+      auto [d2x, d2y] = meters(segment.calc_d2(u[i]));
+      double num = (px - x) * dx + (py - y) * dy;
+      double den = dx * dx + dy * dy + (px - x) * d2x + (py - y) * d2y;
+      if (den != 0.0) { u[i] = std::clamp(u[i] - num / den, 0.0, 1.0); }
+    }
+  }
+
+  /**
+   * Find the heading from a point towards another point, measured to the first point which is at
+   * least the tolerance away.
+   */
+  QAngle direction(size_t from, size_t to) const {
+    return points[from].angleTo(points[reach(from, to)]);
+  }
+
+  /**
+   * Find the first point from a point towards another point which is at least the tolerance away.
+   */
+  size_t reach(size_t from, size_t to) const {
+    size_t i = from;
+    while (i != to && points[i].distTo(points[from]) < tolerance) {
+      i = to > from ? i + 1 : i - 1;
+    }
+    return i;
+  }
+
+  static std::pair<double, double> meters(const Vector& ip) {
+    return {ip.x.convert(meter), ip.y.convert(meter)};
+  }
+};
+
+/**
+ * Helper function used to fit a Piecewise of splines to a list of states, for example a route that
+ * was recorded from odometry. See Fitter for how the fit is found.
+ *
+ * @tparam P The type of spline to fit, either CubicBezier or a Hermite.
+ * @param  trace      The recorded states. Must contain at least two different points.
+ * @param  tolerance  The maximum distance between the piecewise and any of the points.
+ * @param  iterations The maximum number of times the `t` of each point is refined before a
+ *                    segment is split.
+ * @return A Piecewise<P, std::dynamic_extent>.
+ */
+template <class P>
+auto fit(std::span<const State> trace, const QLength& tolerance, size_t iterations = 4) {
+  return Fitter<P>::fit(trace, tolerance, iterations);
+}
+
+} // namespace lib7842
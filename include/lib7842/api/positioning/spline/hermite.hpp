@@ -1,14 +1,15 @@
 #pragma once
 #include "parametric.hpp"
 #include "piecewise.hpp"
+#include "polynomial.hpp"
 #include "spline.hpp"
 
 namespace lib7842 {
 
 // forward declaration
-template <size_t N> class HermiteFnc;
+template <size_t N, class S = double> class HermiteFnc;
 // aliases
-template <size_t N> using Hermite = Parametric<HermiteFnc<N>>;
+template <size_t N, class S = double> using Hermite = Parametric<HermiteFnc<N, S>>;
 using CubicHermite = Hermite<3>;
 using QuinticHermite = Hermite<5>;
 
@@ -18,15 +19,18 @@ using QuinticHermite = Hermite<5>;
  * ends at the last point with the last tangent. By scaling the tangents, the "stretch" parameter of
  * the function can be controlled, which is essentially the weight of the tangents. The hermite
  * function is calculated using a generic implementation that only requires the coefficients of x^i
- * to be solved ahead of time. https://en.wikipedia.org/wiki/Cubic_Hermite_spline
+ * to be solved ahead of time, which are then sampled by the PolynomialFnc.
+ * https://en.wikipedia.org/wiki/Cubic_Hermite_spline
  *
  * This class is designed to be used with the Parametric class to produce a two-dimensional spline.
  * Hermite<N> is an alias for Parametric<HermiteFnc<N>>. There are also aliases for CubicHermite and
- * QuinticHermite which are the only orders currently supported.
+ * QuinticHermite which are the only orders currently supported. A Hermite<N, float> is evaluated in
+ * single precision.
  *
- * @tparam N The order of the Hermite.
+ * @tparam N The order of the Hermite, either 3 or 5.
+ * @tparam S The scalar type used to evaluate the function, see PolynomialFnc.
  */
-template <size_t N> class HermiteFnc : public ParametricFnc {
+template <size_t N, class S> class HermiteFnc : public PolynomialFnc<N, S> {
 public:
   /**
    * Create a new one-dimensional HermiteFnc given a start and end value and their tangents.
@@ -36,86 +40,45 @@ public:
    * @param end     The ending value of the function.
    * @param end_t   The ending tangent of the function.
    */
-  constexpr HermiteFnc(double start, double start_t, double end, double end_t);
-
-  /**
-   * Calculate the y value of the hermite given x.
-   *
-   * @param  x The input value in the range of [0, 1].
-   * @return The calculated y value.
-   */
-  constexpr double calc(double x) const override {
-    double sum {0};
-    for (size_t i = 0; i < coeffs.size(); ++i) {
-      sum += coeffs.at(i) * std::pow(x, i);
-    }
-    return sum;
+  constexpr HermiteFnc(double start, double start_t, double end, double end_t) {
+    this->set(solve(start, start_t, end, end_t));
   }
 
-  /**
-   * Calculate the first derivative of the hermite given x using the power rule.
-   *
-   * @param  x The input value in the range of [0, 1].
-   * @return The calculated first derivative.
-   */
-  constexpr double calc_d(double x) const override {
-    double sum {0};
-    for (size_t i = 1; i < coeffs.size(); ++i) {
-      sum += coeffs.at(i) * i * std::pow(x, i - 1);
-    }
-    return sum;
-  }
+  constexpr ~HermiteFnc() override {}
 
+protected:
   /**
-   * Calculate the second derivative of the hermite given x using the power rule.
-   *
-   * @param  x The input value in the range of [0, 1].
-   * @return The calculated second derivative.
+   * Solve for the coefficients of a cubic or quintic hermite.
    */
-  constexpr double calc_d2(double x) const override {
-    double sum {0};
-    for (size_t i = 2; i < coeffs.size(); ++i) {
-      sum += coeffs.at(i) * i * (i - 1) * std::pow(x, i - 2);
-    }
-    return sum;
-  }
+  static constexpr std::array<double, N + 1> solve(double start, double start_t, double end,
+                                                    double end_t) {
+    static_assert(N == 3 || N == 5, "HermiteFnc: only cubic and quintic hermites are supported");
+    if constexpr (N == 3) {
+      double u = end - start;
 
-  static constexpr size_t order = N;
+      double a2 = 3.0 * u - 2.0 * start_t - end_t;
+      double a3 = -2.0 * u + start_t + end_t;
 
-protected:
-  std::array<double, N + 1> coeffs {};
-};
-
-/**
- * Template specializations for a cubic and quintic hermite.
- */
-template <>
-constexpr HermiteFnc<3>::HermiteFnc(double start, double start_t, double end, double end_t) {
-  double u = end - start;
-
-  double a2 = 3.0 * u - 2.0 * start_t - end_t;
-  double a3 = -2.0 * u + start_t + end_t;
-
-  coeffs = {start, start_t, a2, a3};
-}
-
-template <>
-constexpr HermiteFnc<5>::HermiteFnc(double start, double start_t, double end, double end_t) {
-  double u = end - start - start_t;
-  double v = end_t - start_t;
+      return {start, start_t, a2, a3};
+    } else {
+      double u = end - start - start_t;
+      double v = end_t - start_t;
 
-  double a3 = 10.0 * u - 4.0 * v;
-  double a4 = -15.0 * u + 7.0 * v;
-  double a5 = 6.0 * u - 3.0 * v;
+      double a3 = 10.0 * u - 4.0 * v;
+      double a4 = -15.0 * u + 7.0 * v;
+      double a5 = 6.0 * u - 3.0 * v;
 
-  coeffs = {start, start_t, 0.0, a3, a4, a5};
-}
+      return {start, start_t, 0.0, a3, a4, a5};
+    }
+  }
+};
 
 /**
  * Specialization for a Parametric<HermiteFnc<N>> which allows construction using a start and end
  * state.
  */
-template <size_t N> class Parametric<HermiteFnc<N>> : public Parametric<HermiteFnc<N>, true> {
+template <size_t N, class S>
+class Parametric<HermiteFnc<N, S>> final : public Parametric<HermiteFnc<N, S>, true> {
 public:
   /**
    * Helper method to construct a Piecewise<HermiteFnc<N> given a start and end state and their
@@ -129,11 +92,11 @@ public:
    */
   constexpr Parametric(const State& start, const State& end, double startStretch,
                        double endStretch) :
-    Parametric<HermiteFnc<N>, true>(
-      HermiteFnc<N>(start.x.convert(meter), cos(start.theta).convert(number) * startStretch,
-                    end.x.convert(meter), cos(end.theta).convert(number) * endStretch),
-      HermiteFnc<N>(start.y.convert(meter), sin(start.theta).convert(number) * startStretch,
-                    end.y.convert(meter), sin(end.theta).convert(number) * endStretch)) {}
+    Parametric<HermiteFnc<N, S>, true>(
+      HermiteFnc<N, S>(start.x.convert(meter), cos(start.theta).convert(number) * startStretch,
+                       end.x.convert(meter), cos(end.theta).convert(number) * endStretch),
+      HermiteFnc<N, S>(start.y.convert(meter), sin(start.theta).convert(number) * startStretch,
+                       end.y.convert(meter), sin(end.theta).convert(number) * endStretch)) {}
 
   /**
    * Helper method to construct a Parametric<HermiteFnc<N> given a start and end state and an
@@ -195,6 +158,8 @@ public:
    */
   constexpr explicit Parametric(const QAngle& start, const State& end, double stretch = 1) :
     Parametric({0_m, 0_m, start}, end, stretch, stretch) {}
+
+  constexpr ~Parametric() override {}
 };
 
 /**
@@ -207,7 +172,7 @@ public:
  * @return A Piecewise<P, N-1>>.
  */
 template <class P, size_t N>
-requires std::same_as<P, Hermite<P::type::order>>
+requires std::same_as<P, Hermite<P::type::order, typename P::type::scalar>>
 constexpr auto make_piecewise(State(&&ip)[N]) {
   std::array<std::optional<P>, N - 1> p;
   for (size_t i = 0; i < N - 1; ++i) {
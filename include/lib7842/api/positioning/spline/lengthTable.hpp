@@ -0,0 +1,95 @@
+#pragma once
+#include "lib7842/api/other/units.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace lib7842 {
+
+/**
+ * A LengthTable is a precomputed map between `t` and the distance travelled along a spline. The
+ * spline is divided into a number of intervals that are evenly spaced in `t`, and the length of
+ * each interval is found by integrating the velocity of the spline using Simpson's rule. Since the
+ * accumulated length is monotone, finding `t` given a distance is a binary search followed by a
+ * linear interpolation between the two neighbouring samples. Finding the distance given `t` is a
+ * direct lookup.
+ *
+ * The table does not keep a reference to the spline, so it can be built once at the beginning of a
+ * motion and queried as many times as needed without evaluating the spline again.
+ */
+class LengthTable {
+public:
+  /**
+   * Build a new table by sampling the velocity of a spline.
+   *
+   * @param spline     The spline to sample.
+   * @param resolution The number of intervals to divide the spline into. Must be greater than zero.
+   */
+  template <class T> explicit LengthTable(const T& spline, size_t resolution = 100) {
+    if (resolution == 0) {
+      throw std::invalid_argument("LengthTable: resolution must be greater than zero");
+    }
+
+    // sample the ends and middle of every interval in a single batch
+    std::vector<double> ts(2 * resolution + 1);
+    for (size_t i = 0; i < ts.size(); ++i) {
+      ts[i] = static_cast<double>(i) / (2 * resolution);
+    }
+    std::vector<QLength> vels(ts.size());
+    spline.velocity_batch(ts, vels);
+
+    lengths.reserve(resolution + 1);
+    lengths.emplace_back(0_m);
+    for (size_t i = 1; i <= resolution; ++i) {
+      QLength prev = vels[2 * i - 2].abs();
+      QLength mid = vels[2 * i - 1].abs();
+      QLength next = vels[2 * i].abs();
+      lengths.emplace_back(lengths.back() + (prev + 4.0 * mid + next) / (6.0 * resolution));
+    }
+  }
+
+  /**
+   * Find the value of `t` at which a certain distance has been travelled along the spline.
+   *
+   * @param  dist The distance travelled from the start of the spline.
+   * @return The value of `t`, in the range of [0, 1].
+   */
+  double t_at_length(const QLength& dist) const {
+    if (dist <= 0_m) { return 0.0; }
+    if (dist >= length()) { return 1.0; }
+
+    // the first sample that is further than dist, which is never the first sample
+    size_t i = std::upper_bound(lengths.begin(), lengths.end(), dist) - lengths.begin();
+    QLength span = lengths[i] - lengths[i - 1];
+    double x = span > 0_m ? ((dist - lengths[i - 1]) / span).convert(number) : 0.0;
+    return (i - 1 + x) / resolution();
+  }
+
+  /**
+   * Find the distance that has been travelled along the spline at a given `t`.
+   *
+   * @param  t Where along the spline to sample, in the range of [0, 1].
+   * @return The distance travelled from the start of the spline.
+   */
+  QLength length_at_t(double t) const {
+    double x = std::clamp(t, 0.0, 1.0) * resolution();
+    // use the last interval for t = 1
+    size_t i = std::min(static_cast<size_t>(x), resolution() - 1);
+    return lengths[i] + (lengths[i + 1] - lengths[i]) * (x - i);
+  }
+
+  /**
+   * The total length of the spline.
+   */
+  QLength length() const { return lengths.back(); }
+
+  /**
+   * The number of intervals the spline was divided into.
+   */
+  size_t resolution() const { return lengths.size() - 1; }
+
+protected:
+  std::vector<QLength> lengths {}; // the accumulated length at each sample
+};
+
+} // namespace lib7842
@@ -10,7 +10,7 @@ namespace lib7842 {
 /**
  * This class describes a line which connects two points together.
  */
-class Line : public SplineHelper<Line> {
+class Line final : public SplineHelper<Line> {
 public:
   /**
    * Create a new line given the coordinates of two points.
@@ -29,6 +29,8 @@ public:
    */
   constexpr explicit Line(const Vector& iend) : Line({0_m, 0_m}, iend) {}
 
+  constexpr ~Line() override {}
+
   /**
    * Sample the point along the spline which is between the start and end points using linear
    * interpolation given t.
@@ -38,6 +40,13 @@ public:
    */
   constexpr State calc(double t) const override { return start + (end - start) * t; }
 
+  /**
+   * The derivatives of a line. The first derivative is the difference between the end and start
+   * points, and the second derivative is always zero.
+   */
+  constexpr Vector calc_d(double /*t*/) const override { return (end - start).vector(); }
+  constexpr Vector calc_d2(double /*t*/) const override { return {0_m, 0_m}; }
+
   /**
    * The curvature of a line is always zero.
    */
@@ -47,6 +56,33 @@ public:
    * Calculate the length of the line which is the distance between the start and end points.
    */
   constexpr QLength length(double /*resolution*/ = 0) const override { return start.distTo(end); }
+  constexpr QLength arc_length(const QLength& /*tolerance*/ = 0_m) const override {
+    return length();
+  }
+
+  /**
+   * Sample many points along the line. The difference between the end and start points is only
+   * found once.
+   */
+  constexpr void calc_batch(std::span<const double> ts, std::span<State> out) const override {
+    check_batch(ts.size(), out.size());
+    State diff = end - start;
+    for (size_t i = 0; i < ts.size(); ++i) {
+      out[i] = start + diff * ts[i];
+    }
+  }
+
+  constexpr void curvature_batch(std::span<const double> ts,
+                                 std::span<QCurvature> out) const override {
+    check_batch(ts.size(), out.size());
+    std::fill_n(out.begin(), ts.size(), 0 / meter);
+  }
+
+  constexpr void velocity_batch(std::span<const double> ts,
+                                std::span<QLength> out) const override {
+    check_batch(ts.size(), out.size());
+    std::fill_n(out.begin(), ts.size(), length());
+  }
 
 protected:
   State start;
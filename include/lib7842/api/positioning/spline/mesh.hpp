@@ -7,7 +7,7 @@ namespace lib7842 {
  * This class describes a hybrid arc which connects two points together by linearly interpolating
  * between two arcs.
  */
-class Mesh : public SplineHelper<Mesh> {
+class Mesh final : public SplineHelper<Mesh> {
 public:
   constexpr Mesh(const State& istart, const State& iend) :
     first(istart, State(iend.x, iend.y, 2 * istart.Vector::angleTo(iend) - istart.theta)),
@@ -16,6 +16,8 @@ public:
   constexpr explicit Mesh(const State& iend) : Mesh({0_m, 0_m, 0_deg}, iend) {}
   constexpr Mesh(const QAngle& istart, const State& iend) : Mesh({0_m, 0_m, istart}, iend) {}
 
+  constexpr ~Mesh() override {}
+
   constexpr State calc(double t) const override {
     auto first_p = first.calc(t);
     auto second_p = second.calc(t);
@@ -28,30 +30,47 @@ public:
   }
 
   constexpr QCurvature curvature(double t) const override {
-    auto d = calc_d(t);
-    auto d2 = calc_d2(t);
-    return ((d.x * d2.y - d.y * d2.x) / pow<3>(sqrt(d.x * d.x + d.y * d.y)));
+    auto [p, d, d2] = calc_all(t);
+    return curvature(d, d2);
   }
 
-  constexpr Vector calc_d(double t) const {
-    auto first_p = first.calc(t).vector();
-    auto second_p = second.calc(t).vector();
-    auto first_d = first.calc_d(t);
-    auto second_d = second.calc_d(t);
-    return (first_p * -1.0) + first_d * (1 - t) + second_p + second_d * t;
+  constexpr Vector calc_d(double t) const override { return std::get<1>(calc_all(t)); }
+  constexpr Vector calc_d2(double t) const override { return std::get<2>(calc_all(t)); }
+
+  /**
+   * Sample the point, velocity, and curvature of the mesh at t. Each arc is only sampled once, and
+   * the point and derivatives of the mesh are blended from them.
+   *
+   * @param  t Where along the spline to sample, in the range of [0, 1].
+   * @return The sampled point, velocity, and curvature at t.
+   */
+  constexpr Spline::Sample evaluate(double t) const override {
+    auto [p, d, d2] = calc_all(t);
+    return {p, sqrt(square(d.x) + square(d.y)), curvature(d, d2)};
   }
 
-  constexpr Vector calc_d2(double t) const {
-    auto first_d = first.calc_d(t);
-    auto second_d = second.calc_d(t);
-    auto first_d2 = first.calc_d2(t);
-    auto second_d2 = second.calc_d2(t);
-    return first_d * -2 + first_d2 * (1 - t) + second_d * 2 + second_d2 * t;
+  /**
+   * Sample the point and both derivatives of the mesh at t. The mesh is p(t) = a(t)(1-t) + b(t)t,
+   * so its derivatives follow from the product rule.
+   *
+   * @param  t Where along the spline to sample, in the range of [0, 1].
+   * @return The point, first derivative, and second derivative at t.
+   */
+  constexpr std::tuple<State, Vector, Vector> calc_all(double t) const {
+    auto [first_p, first_d, first_d2] = first.calc_all(t);
+    auto [second_p, second_d, second_d2] = second.calc_all(t);
+    return {first_p * (1 - t) + second_p * t,
+            second_p.vector() - first_p.vector() + first_d * (1 - t) + second_d * t,
+            (second_d - first_d) * 2 + first_d2 * (1 - t) + second_d2 * t};
   }
 
 protected:
   Arc first;
   Arc second;
+
+  static constexpr QCurvature curvature(const Vector& d, const Vector& d2) {
+    return ((d.x * d2.y - d.y * d2.x) / pow<3>(sqrt(d.x * d.x + d.y * d.y)));
+  }
 };
 
 /**
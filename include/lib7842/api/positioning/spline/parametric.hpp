@@ -1,5 +1,9 @@
 #pragma once
+#include "lib7842/api/other/jet.hpp"
 #include "spline.hpp"
+#include <algorithm>
+#include <array>
+#include <span>
 
 namespace lib7842 {
 
@@ -32,6 +36,93 @@ public:
    * @return The calculated second derivative.
    */
   virtual constexpr double calc_d2(double x) const = 0;
+  /**
+   * Calculate the y value, first derivative, and second derivative of the function given x. This
+   * has a default implementation that calls the three methods, but functions that share work
+   * between them should override it to calculate everything in one pass.
+   *
+   * @param  x The input value in the range of [0, 1].
+   * @return The y value, first derivative, and second derivative.
+   */
+  virtual constexpr std::array<double, 3> evaluate(double x) const {
+    return {calc(x), calc_d(x), calc_d2(x)};
+  }
+
+  /**
+   * Calculate the y value, first derivative, or second derivative of the function at many values
+   * of x. These have default implementations that loop over the single methods, but functions
+   * should override them with loops that the compiler can vectorize.
+   *
+   * @param xs  The input values, each in the range of [0, 1].
+   * @param out The calculated values. Must be at least as large as xs.
+   */
+  virtual constexpr void calc_batch(std::span<const double> xs, std::span<double> out) const {
+    for (size_t i = 0; i < xs.size(); ++i) {
+      out[i] = calc(xs[i]);
+    }
+  }
+  virtual constexpr void calc_d_batch(std::span<const double> xs, std::span<double> out) const {
+    for (size_t i = 0; i < xs.size(); ++i) {
+      out[i] = calc_d(xs[i]);
+    }
+  }
+  virtual constexpr void calc_d2_batch(std::span<const double> xs, std::span<double> out) const {
+    for (size_t i = 0; i < xs.size(); ++i) {
+      out[i] = calc_d2(xs[i]);
+    }
+  }
+};
+
+/**
+ * An AutoFnc is a ParametricFnc whose derivatives are found automatically. The function only needs
+ * to be written once, as a `calc` method (or call operator) that is generic over its number type.
+ * The value is calculated by calling it with a double, and the derivatives by calling it with a
+ * util::Jet, which finds the value and both derivatives in a single pass.
+ *
+ * For example, a sine wave can be written as:
+ * ```
+ * struct Sine {
+ *   double amplitude;
+ *   template <class T> constexpr T calc(T x) const {
+ *     using std::sin;
+ *     return amplitude * sin(x * 2.0 * 3.14159265358979);
+ *   }
+ * };
+ * Parametric<AutoFnc<Sine>> wave(AutoFnc(Sine {0.0}), AutoFnc(Sine {1.0}));
+ * ```
+ *
+ * @tparam F The type of the generic function.
+ */
+template <class F> class AutoFnc : public ParametricFnc {
+public:
+  /**
+   * Create a new AutoFnc given a generic function.
+   *
+   * @param ifnc The function, which has a `calc` method or call operator that is generic over its
+   *             number type.
+   */
+  constexpr explicit AutoFnc(F ifnc) : fnc(std::move(ifnc)) {}
+
+  constexpr ~AutoFnc() override {}
+
+  constexpr double calc(double x) const override { return invoke(x); }
+  constexpr double calc_d(double x) const override { return invoke(util::Jet::variable(x)).d; }
+  constexpr double calc_d2(double x) const override { return invoke(util::Jet::variable(x)).d2; }
+  constexpr std::array<double, 3> evaluate(double x) const override {
+    util::Jet y = invoke(util::Jet::variable(x));
+    return {y.v, y.d, y.d2};
+  }
+
+protected:
+  F fnc;
+
+  template <class T> constexpr T invoke(const T& x) const {
+    if constexpr (requires { fnc.calc(x); }) {
+      return fnc.calc(x);
+    } else {
+      return fnc(x);
+    }
+  }
 };
 
 // template <class T> concept IsParametricFnc = std::derived_from<ParametricFnc, T>;
@@ -59,6 +150,8 @@ public:
    */
   constexpr Parametric(T&& x, T&& y) : p(std::forward<T>(x), std::forward<T>(y)) {}
 
+  constexpr ~Parametric() override {}
+
   /**
    * Sample the point along the spline given t. The angle of the point is equal to the arctan of the
    * derivatives of the two functions.
@@ -76,6 +169,20 @@ public:
     return State(x_t, y_t, atan2(y1_t, x1_t));
   }
 
+  /**
+   * Sample the first or second derivative of the point along the spline given t, which are the
+   * derivatives of the two functions.
+   *
+   * @param  t Where along the spline to sample, in the range of [0, 1].
+   * @return The derivative at t.
+   */
+  constexpr Vector calc_d(double t) const override {
+    return {p.first.calc_d(t) * meter, p.second.calc_d(t) * meter};
+  }
+  constexpr Vector calc_d2(double t) const override {
+    return {p.first.calc_d2(t) * meter, p.second.calc_d2(t) * meter};
+  }
+
   /**
    * Sample the curvature of the spline at t. Curvature is the inverse of the radius.
    * https://en.wikipedia.org/wiki/Curvature#In_terms_of_a_general_parametrization
@@ -103,6 +210,86 @@ public:
     return sqrt(square(p.first.calc_d(t) * meter) + square(p.second.calc_d(t) * meter));
   }
 
+  /**
+   * Sample the point, velocity, and curvature of the spline at t. Both functions are only
+   * evaluated once, which is much faster than calling calc, velocity, and curvature separately.
+   *
+   * @param  t Where along the spline to sample, in the range of [0, 1].
+   * @return The sampled point, velocity, and curvature at t.
+   */
+  constexpr Spline::Sample evaluate(double t) const override {
+    auto [x, x_d, x_d_2] = p.first.evaluate(t);
+    auto [y, y_d, y_d_2] = p.second.evaluate(t);
+    QLength vel = sqrt(square(x_d * meter) + square(y_d * meter));
+    QCurvature curvature = (x_d * y_d_2 - y_d * x_d_2) * square(meter) / pow<3>(vel);
+    return {State(x * meter, y * meter, atan2(y_d * meter, x_d * meter)), vel, curvature};
+  }
+
+  /**
+   * Sample the points along the spline at many values of t. The functions are evaluated in chunks
+   * into buffers on the stack, which lets them use vectorized loops.
+   *
+   * @param ts  Where along the spline to sample, each in the range of [0, 1].
+   * @param out The sampled points. Must be at least as large as ts.
+   */
+  constexpr void calc_batch(std::span<const double> ts, std::span<State> out) const override {
+    Spline::check_batch(ts.size(), out.size());
+    std::array<double, Spline::batch_size> x {}, y {}, x_d {}, y_d {};
+    for (size_t i = 0; i < ts.size(); i += Spline::batch_size) {
+      auto chunk = ts.subspan(i, std::min(Spline::batch_size, ts.size() - i));
+      p.first.calc_batch(chunk, x);
+      p.second.calc_batch(chunk, y);
+      p.first.calc_d_batch(chunk, x_d);
+      p.second.calc_d_batch(chunk, y_d);
+      for (size_t j = 0; j < chunk.size(); ++j) {
+        out[i + j] = State(x[j] * meter, y[j] * meter, atan2(y_d[j] * meter, x_d[j] * meter));
+      }
+    }
+  }
+
+  /**
+   * Sample the curvature of the spline at many values of t.
+   *
+   * @param ts  Where along the spline to sample, each in the range of [0, 1].
+   * @param out The curvatures. Must be at least as large as ts.
+   */
+  constexpr void curvature_batch(std::span<const double> ts,
+                                 std::span<QCurvature> out) const override {
+    Spline::check_batch(ts.size(), out.size());
+    std::array<double, Spline::batch_size> x_d {}, y_d {}, x_d_2 {}, y_d_2 {};
+    for (size_t i = 0; i < ts.size(); i += Spline::batch_size) {
+      auto chunk = ts.subspan(i, std::min(Spline::batch_size, ts.size() - i));
+      p.first.calc_d_batch(chunk, x_d);
+      p.second.calc_d_batch(chunk, y_d);
+      p.first.calc_d2_batch(chunk, x_d_2);
+      p.second.calc_d2_batch(chunk, y_d_2);
+      for (size_t j = 0; j < chunk.size(); ++j) {
+        double vel = std::sqrt(x_d[j] * x_d[j] + y_d[j] * y_d[j]);
+        out[i + j] = (x_d[j] * y_d_2[j] - y_d[j] * x_d_2[j]) / (vel * vel * vel) / meter;
+      }
+    }
+  }
+
+  /**
+   * Sample the velocity of the spline at many values of t.
+   *
+   * @param ts  Where along the spline to sample, each in the range of [0, 1].
+   * @param out The velocities. Must be at least as large as ts.
+   */
+  constexpr void velocity_batch(std::span<const double> ts,
+                                std::span<QLength> out) const override {
+    Spline::check_batch(ts.size(), out.size());
+    std::array<double, Spline::batch_size> x_d {}, y_d {};
+    for (size_t i = 0; i < ts.size(); i += Spline::batch_size) {
+      auto chunk = ts.subspan(i, std::min(Spline::batch_size, ts.size() - i));
+      p.first.calc_d_batch(chunk, x_d);
+      p.second.calc_d_batch(chunk, y_d);
+      for (size_t j = 0; j < chunk.size(); ++j) {
+        out[i + j] = std::sqrt(x_d[j] * x_d[j] + y_d[j] * y_d[j]) * meter;
+      }
+    }
+  }
+
   using type = T;
 
 protected:
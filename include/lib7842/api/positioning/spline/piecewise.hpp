@@ -2,8 +2,14 @@
 #include "lib7842/api/other/units.hpp"
 #include "lib7842/api/positioning/point/state.hpp"
 #include "spline.hpp"
+#include <algorithm>
+#include <concepts>
 #include <numeric>
 #include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
 
 namespace lib7842 {
 
@@ -14,7 +20,7 @@ namespace lib7842 {
  * @tparam S The type of spline used for the piecewise.
  * @tparam N The number of splines in the piecewise.
  */
-template <class S, size_t N> class Piecewise : public SplineHelper<Piecewise<S, N>> {
+template <class S, size_t N> class Piecewise final : public SplineHelper<Piecewise<S, N>> {
 public:
   /**
    * Construct a new Piecewise given an array of splines. This constructor is not intended to be
@@ -36,6 +42,8 @@ public:
    */
   constexpr explicit Piecewise(std::array<std::optional<S>, N>&& ip) : p(ip) {}
 
+  constexpr ~Piecewise() override {}
+
   /**
    * Provides all the necessary Spline overrides. These work by mapping `t` over the range of the
    * entire piecewise. This handles the knots (intersections) of the individual splines by choosing
@@ -48,12 +56,30 @@ public:
   constexpr State calc(double t) const override { return get(t, &S::calc); }
   constexpr QCurvature curvature(double t) const override { return get(t, &S::curvature); }
   constexpr QLength velocity(double t) const override { return get(t, &S::velocity) * N; }
+  constexpr Vector calc_d(double t) const override { return get(t, &S::calc_d) * N; }
+  constexpr Vector calc_d2(double t) const override { return get(t, &S::calc_d2) * (N * N); }
+  constexpr Spline::Sample evaluate(double t) const override {
+    auto sample = get(t, &S::evaluate);
+    sample.velocity *= N;
+    return sample;
+  }
   constexpr QLength length(double resolution) const override {
     return std::accumulate(std::begin(p), std::end(p), 0_m, [&](const QLength& l, const auto& ip) {
-      return l + ip.value().length(resolution);
+      return l + ip.value().cached_length(resolution);
+    });
+  }
+  constexpr QLength arc_length(const QLength& tolerance = 0.1_mm) const override {
+    return std::accumulate(std::begin(p), std::end(p), 0_m, [&](const QLength& l, const auto& ip) {
+      return l + ip.value().cached_arc_length(tolerance / N);
     });
   }
 
+  /**
+   * The number of splines in the piecewise, and access to each of them.
+   */
+  static constexpr size_t size() { return N; }
+  constexpr const S& segment(size_t i) const { return p[i].value(); }
+
 protected:
   std::array<std::optional<S>, N> p;
 
@@ -74,6 +100,118 @@ protected:
   }
 };
 
+/**
+ * A Piecewise with a number of splines that is only known at runtime, such as a path that is loaded
+ * from a file or built from a list of waypoints. Unlike the fixed-size Piecewise, `t` is spread out
+ * according to the length of each spline rather than equally, so that travelling along `t` at a
+ * constant rate moves along the piecewise at a roughly constant speed, no matter how different the
+ * lengths of the splines are.
+ *
+ * The accumulated length at the start of each spline is found once when the piecewise is created,
+ * so mapping `t` to a spline is a binary search.
+ *
+ * @tparam S The type of spline used for the piecewise.
+ */
+template <class S>
+class Piecewise<S, std::dynamic_extent> final :
+  public SplineHelper<Piecewise<S, std::dynamic_extent>> {
+public:
+  /**
+   * Construct a new Piecewise given a list of splines. Must contain at least one spline.
+   *
+   * @param ip The list of splines.
+   */
+  explicit Piecewise(std::vector<S>&& ip) : p(std::move(ip)) {
+    if (p.empty()) { throw std::invalid_argument("Piecewise: must contain at least one spline"); }
+    lengths.reserve(p.size() + 1);
+    lengths.emplace_back(0_m);
+    for (const auto& spline : p) {
+      lengths.emplace_back(lengths.back() + spline.cached_arc_length());
+    }
+  }
+
+  /**
+   * Provides all the necessary Spline overrides. These work by mapping `t` to a distance along the
+   * entire piecewise and finding the spline that contains that distance. This handles the knots of
+   * the individual splines by choosing the beginning of the next spline over the end of the current
+   * spline (unless the current spline is the last one in the piecewise).
+   *
+   * @param  t Where along the spline to sample, in the range of [0, 1].
+   * @return The sampled point at t.
+   */
+  State calc(double t) const override { return get(t, &S::calc); }
+  QCurvature curvature(double t) const override { return get(t, &S::curvature); }
+  QLength velocity(double t) const override { return get(t, &S::velocity) * scale(t); }
+  Vector calc_d(double t) const override { return get(t, &S::calc_d) * scale(t); }
+  Vector calc_d2(double t) const override {
+    double k = scale(t);
+    return get(t, &S::calc_d2) * (k * k);
+  }
+  Spline::Sample evaluate(double t) const override {
+    auto sample = get(t, &S::evaluate);
+    sample.velocity *= scale(t);
+    return sample;
+  }
+  QLength length(double resolution) const override {
+    return std::accumulate(p.begin(), p.end(), 0_m, [&](const QLength& l, const S& ip) {
+      return l + ip.cached_length(resolution);
+    });
+  }
+  QLength arc_length(const QLength& tolerance = 0.1_mm) const override {
+    return std::accumulate(p.begin(), p.end(), 0_m, [&](const QLength& l, const S& ip) {
+      return l + ip.cached_arc_length(tolerance / p.size());
+    });
+  }
+
+  /**
+   * The number of splines in the piecewise, and access to each of them.
+   */
+  size_t size() const { return p.size(); }
+  const S& segment(size_t i) const { return p[i]; }
+
+protected:
+  std::vector<S> p;
+  std::vector<QLength> lengths; // the accumulated length at the start of each spline
+
+  /**
+   * Find which spline contains the distance along the piecewise that corresponds to t.
+   *
+   * @param  t Where along the spline to sample, in the range of [0, 1].
+   * @return The index of the spline.
+   */
+  size_t index(double t) const {
+    QLength dist = std::clamp(t, 0.0, 1.0) * lengths.back();
+    // the first spline that starts further than dist, which is never the first spline
+    size_t i = std::upper_bound(lengths.begin(), lengths.end(), dist) - lengths.begin();
+    // use t = 1 for the last spline
+    return std::min(i, p.size()) - 1;
+  }
+
+  /**
+   * The ratio between the change in t of a spline and the change in t of the piecewise.
+   */
+  double scale(double t) const {
+    size_t i = index(t);
+    QLength span = lengths[i + 1] - lengths[i];
+    return span > 0_m ? (lengths.back() / span).convert(number) : 0.0;
+  }
+
+  /**
+   * Helper function to map the value of t over the range of the piecewise.
+   *
+   * @param  t Where along the spline to sample, in the range of [0, 1].
+   * @param  f What value to get from the spline.
+   * @return The value sampled from one of the splines according to t and f.
+   */
+  auto get(double t, const auto& f) const {
+    size_t i = index(t);
+    QLength span = lengths[i + 1] - lengths[i];
+    QLength dist = std::clamp(t, 0.0, 1.0) * lengths.back() - lengths[i];
+    double x = span > 0_m ? std::clamp((dist / span).convert(number), 0.0, 1.0) : 0.0;
+    return std::invoke(f, p[i], x);
+  }
+};
+
 /**
  * Helper function to construct a piecewise. Use this instead of the Piecewise constructors, as it
  * allows you to omit some template parameters in favor of deduction. There are overloads of this
@@ -89,4 +227,45 @@ template <class S, size_t N> constexpr auto make_piecewise(S(&&ip)[N]) {
   return Piecewise<S, N>(std::move(ip));
 }
 
+/**
+ * Helper function to construct a piecewise from a list of splines whose size is only known at
+ * runtime. The type of the list is always deduced, so that a braced list of splines still selects
+ * the fixed-size overload.
+ *
+ * @param  ip The list of splines, a `std::vector<S>` rvalue.
+ * @return A Piecewise<S, std::dynamic_extent>.
+ */
+template <class V>
+requires std::same_as<V, std::vector<typename V::value_type>>
+auto make_piecewise(V&& ip) {
+  return Piecewise<typename V::value_type, std::dynamic_extent>(std::move(ip));
+}
+
+/**
+ * Helper function used to create a runtime-sized Piecewise by joining each pair of neighbouring
+ * waypoints with a spline, for example a list of waypoints that was loaded from a file. This works
+ * for any spline made from two waypoints, such as a Line, Arc, Mesh, or Hermite. Must contain at
+ * least two waypoints.
+ *
+ * @param  ip The list of waypoints, such as a `std::vector<State>` or `std::span<const Vector>`.
+ * @tparam P  The type of spline, which is created from two waypoints.
+ * @return A Piecewise<P, std::dynamic_extent>.
+ */
+template <class P, std::ranges::contiguous_range R>
+requires std::derived_from<P, Spline> &&
+         std::constructible_from<P, const std::ranges::range_value_t<R>&,
+                                 const std::ranges::range_value_t<R>&>
+auto make_piecewise(const R& ip) {
+  std::span waypoints(ip);
+  if (waypoints.size() < 2) {
+    throw std::invalid_argument("make_piecewise: needs at least two waypoints");
+  }
+  std::vector<P> p;
+  p.reserve(waypoints.size() - 1);
+  for (size_t i = 0; i < waypoints.size() - 1; ++i) {
+    p.emplace_back(waypoints[i], waypoints[i + 1]);
+  }
+  return make_piecewise(std::move(p));
+}
+
 } // namespace lib7842
@@ -0,0 +1,174 @@
+#pragma once
+#include "parametric.hpp"
+#include <array>
+#include <concepts>
+
+namespace lib7842 {
+
+/**
+ * A PolynomialFnc is a one-dimensional function of N order that is described by the coefficients of
+ * x^i. The coefficients of the first and second derivatives are found once when the function is
+ * created, so that the function and both derivatives can be sampled using Horner's method, which
+ * only takes N multiplications and additions. https://en.wikipedia.org/wiki/Horner%27s_method
+ *
+ * This class is designed to be the base of functions that can be written in the power basis, such
+ * as the BezierFnc and HermiteFnc, which only need to solve for the coefficients when constructed.
+ *
+ * The coefficients are stored and evaluated in the scalar type S. Using float halves the size of
+ * the coefficients and lets the batch methods use single-precision vector instructions, which are
+ * much faster than double on the V5. The input and output of the function are still doubles, and
+ * the coefficients are always solved in double before they are rounded, so the only error is the
+ * rounding of the evaluation itself, which is about 1e-7 relative to the size of the path.
+ *
+ * @tparam N The order of the polynomial.
+ * @tparam S The scalar type used to evaluate the polynomial, either double or float.
+ */
+template <size_t N, class S = double>
+requires std::floating_point<S>
+class PolynomialFnc : public ParametricFnc {
+public:
+  /**
+   * Create a new one-dimensional PolynomialFnc given the coefficients of x^i.
+   *
+   * @param icoeffs The coefficients, starting with the constant term.
+   */
+  constexpr explicit PolynomialFnc(const std::array<double, N + 1>& icoeffs) { set(icoeffs); }
+
+  constexpr ~PolynomialFnc() override {}
+
+  /**
+   * Calculate the y value of the polynomial given x.
+   *
+   * @param  x The input value in the range of [0, 1].
+   * @return The calculated y value.
+   */
+  constexpr double calc(double x) const override { return horner(coeffs, static_cast<S>(x)); }
+
+  /**
+   * Calculate the first derivative of the polynomial given x.
+   *
+   * @param  x The input value in the range of [0, 1].
+   * @return The calculated first derivative.
+   */
+  constexpr double calc_d(double x) const override { return horner(coeffs_d, static_cast<S>(x)); }
+
+  /**
+   * Calculate the second derivative of the polynomial given x.
+   *
+   * @param  x The input value in the range of [0, 1].
+   * @return The calculated second derivative.
+   */
+  constexpr double calc_d2(double x) const override {
+    return horner(coeffs_d2, static_cast<S>(x));
+  }
+
+  /**
+   * Calculate the y value, first derivative, and second derivative of the polynomial given x in a
+   * single pass of Horner's method.
+   *
+   * @param  x The input value in the range of [0, 1].
+   * @return The y value, first derivative, and second derivative.
+   */
+  constexpr std::array<double, 3> evaluate(double ix) const override {
+    S x = static_cast<S>(ix);
+    S y = coeffs[N];
+    S d {0};
+    S d2 {0};
+    for (size_t i = N; i-- > 0;) {
+      d2 = d2 * x + d;
+      d = d * x + y;
+      y = y * x + coeffs[i];
+    }
+    return {y, d, 2 * d2};
+  }
+
+  /**
+   * Calculate the y value, first derivative, or second derivative of the polynomial at many values
+   * of x. Each step of Horner's method is applied to every x before moving on to the next
+   * coefficient, so the inner loop has no dependencies between iterations and can be vectorized.
+   *
+   * @param xs  The input values, each in the range of [0, 1].
+   * @param out The calculated values. Must be at least as large as xs.
+   */
+  constexpr void calc_batch(std::span<const double> xs, std::span<double> out) const override {
+    horner_batch(coeffs, xs, out);
+  }
+  constexpr void calc_d_batch(std::span<const double> xs, std::span<double> out) const override {
+    horner_batch(coeffs_d, xs, out);
+  }
+  constexpr void calc_d2_batch(std::span<const double> xs, std::span<double> out) const override {
+    horner_batch(coeffs_d2, xs, out);
+  }
+
+  static constexpr size_t order = N;
+  using scalar = S;
+
+protected:
+  constexpr PolynomialFnc() = default;
+
+  /**
+   * Set the coefficients of the polynomial and find the coefficients of its derivatives using the
+   * power rule.
+   */
+  constexpr void set(const std::array<double, N + 1>& icoeffs) {
+    for (size_t i = 0; i < coeffs.size(); ++i) {
+      coeffs[i] = static_cast<S>(icoeffs[i]);
+    }
+    for (size_t i = 0; i < coeffs_d.size(); ++i) {
+      coeffs_d[i] = static_cast<S>(icoeffs[i + 1] * (i + 1));
+    }
+    for (size_t i = 0; i < coeffs_d2.size(); ++i) {
+      coeffs_d2[i] = static_cast<S>(icoeffs[i + 2] * (i + 2) * (i + 1));
+    }
+  }
+
+  /**
+   * Evaluate a polynomial given its coefficients using Horner's method.
+   */
+  template <size_t M> static constexpr S horner(const std::array<S, M>& icoeffs, S x) {
+    S sum {0};
+    for (size_t i = M; i-- > 0;) {
+      sum = sum * x + icoeffs[i];
+    }
+    return sum;
+  }
+
+  /**
+   * Evaluate a polynomial at many values of x using Horner's method. If the scalar is not double,
+   * the values are converted into chunks on the stack, so that the loop runs entirely in S.
+   */
+  template <size_t M>
+  static constexpr void horner_batch(const std::array<S, M>& icoeffs, std::span<const double> xs,
+                                     std::span<double> out) {
+    if constexpr (std::same_as<S, double>) {
+      horner_each(icoeffs, xs, out);
+    } else {
+      constexpr size_t chunk = 64;
+      std::array<S, chunk> x {};
+      std::array<S, chunk> y {};
+      for (size_t i = 0; i < xs.size(); i += chunk) {
+        size_t n = std::min(chunk, xs.size() - i);
+        std::copy_n(xs.begin() + i, n, x.begin());
+        horner_each(icoeffs, std::span<const S>(x.data(), n), std::span<S>(y.data(), n));
+        std::copy_n(y.begin(), n, out.begin() + i);
+      }
+    }
+  }
+
+  template <size_t M>
+  static constexpr void horner_each(const std::array<S, M>& icoeffs, std::span<const S> xs,
+                                    std::span<S> out) {
+    std::fill_n(out.begin(), xs.size(), S {0});
+    for (size_t j = M; j-- > 0;) {
+      for (size_t i = 0; i < xs.size(); ++i) {
+        out[i] = out[i] * xs[i] + icoeffs[j];
+      }
+    }
+  }
+
+  std::array<S, N + 1> coeffs {};
+  std::array<S, N> coeffs_d {};
+  std::array<S, (N > 0 ? N - 1 : 0)> coeffs_d2 {};
+};
+
+} // namespace lib7842
@@ -1,9 +1,18 @@
 #pragma once
+#include "lib7842/api/other/memo.hpp"
+#include "lib7842/api/other/quadrature.hpp"
 #include "lib7842/api/other/units.hpp"
 #include "lib7842/api/positioning/point/state.hpp"
 #include "lib7842/api/positioning/point/vector.hpp"
 #include "stepper.hpp"
+#include <algorithm>
+#include <array>
 #include <functional>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
 
 namespace lib7842 {
 
@@ -13,8 +22,22 @@ namespace lib7842 {
  */
 class Spline {
 public:
+  /**
+   * Splines should declare their destructor as `constexpr ~X() override {}` instead of relying on
+   * the implicit one. GCC can't use an implicit virtual constexpr destructor during constant
+   * evaluation, which would stop the spline from being sampled at compile time.
+   */
   constexpr virtual ~Spline() = default;
 
+  /**
+   * Everything that can be sampled from the spline at a given t.
+   */
+  struct Sample {
+    State state; // the point and angle
+    QLength velocity; // the ratio between distance travelled and change in t
+    QCurvature curvature; // the inverse of the radius
+  };
+
   /**
    * Sample the point along the spline given t.
    *
@@ -40,6 +63,133 @@ public:
    */
   constexpr virtual QLength velocity(double /*t*/) const { return length(); }
 
+  /**
+   * Sample the first derivative of the point along the spline with respect to t. This method has a
+   * default implementation that uses a central difference of calc, but splines should override it
+   * with the exact derivative.
+   *
+   * @param  t Where along the spline to sample, in the range of [0, 1].
+   * @return The first derivative at t.
+   */
+  constexpr virtual Vector calc_d(double t) const {
+    constexpr double h = 1e-4;
+    double a = std::max(t - h, 0.0);
+    double b = std::min(t + h, 1.0);
+    return (calc(b).vector() - calc(a).vector()) / (b - a);
+  }
+
+  /**
+   * Sample the second derivative of the point along the spline with respect to t. This method has
+   * a default implementation that uses a central difference of calc, but splines should override
+   * it with the exact derivative.
+   *
+   * @param  t Where along the spline to sample, in the range of [0, 1].
+   * @return The second derivative at t.
+   */
+  constexpr virtual Vector calc_d2(double t) const {
+    constexpr double h = 1e-3;
+    double c = std::clamp(t, h, 1.0 - h);
+    return (calc(c + h).vector() + calc(c - h).vector() - calc(c).vector() * 2.0) / (h * h);
+  }
+
+  /**
+   * Sample the point, velocity, and curvature of the spline at t. This method has a default
+   * implementation that calls calc, velocity, and curvature, but splines that can share the work
+   * between them should override it.
+   *
+   * @param  t Where along the spline to sample, in the range of [0, 1].
+   * @return The sampled point, velocity, and curvature at t.
+   */
+  constexpr virtual Sample evaluate(double t) const { return {calc(t), velocity(t), curvature(t)}; }
+
+  /**
+   * Sample the points along the spline at many values of t. This method has a default
+   * implementation that calls calc for every t, but splines should override it with loops that the
+   * compiler can vectorize, and hoist any work that does not depend on t.
+   *
+   * @param ts  Where along the spline to sample, each in the range of [0, 1].
+   * @param out The sampled points. Must be at least as large as ts.
+   */
+  constexpr virtual void calc_batch(std::span<const double> ts, std::span<State> out) const {
+    check_batch(ts.size(), out.size());
+    for (size_t i = 0; i < ts.size(); ++i) {
+      out[i] = calc(ts[i]);
+    }
+  }
+
+  /**
+   * Sample the curvature of the spline at many values of t.
+   *
+   * @param ts  Where along the spline to sample, each in the range of [0, 1].
+   * @param out The curvatures. Must be at least as large as ts.
+   */
+  constexpr virtual void curvature_batch(std::span<const double> ts,
+                                         std::span<QCurvature> out) const {
+    check_batch(ts.size(), out.size());
+    for (size_t i = 0; i < ts.size(); ++i) {
+      out[i] = curvature(ts[i]);
+    }
+  }
+
+  /**
+   * Sample the velocity of the spline at many values of t.
+   *
+   * @param ts  Where along the spline to sample, each in the range of [0, 1].
+   * @param out The velocities. Must be at least as large as ts.
+   */
+  constexpr virtual void velocity_batch(std::span<const double> ts, std::span<QLength> out) const {
+    check_batch(ts.size(), out.size());
+    for (size_t i = 0; i < ts.size(); ++i) {
+      out[i] = velocity(ts[i]);
+    }
+  }
+
+  /**
+   * The closest point on the spline to another point.
+   */
+  struct Projection {
+    double t; // where along the spline the closest point is
+    Vector point; // the closest point
+    QLength error; // the distance to the closest point, positive if it is left of the spline
+  };
+
+  /**
+   * Find the point on the spline which is closest to another point. An initial guess for t is
+   * refined using Newton's method to find where the line to the point is perpendicular to the
+   * spline. Without a hint, the guess is the closest of a few evenly spaced samples. When the point
+   * moves a little at a time, such as the position of a robot following the spline, the previous
+   * result is a good hint which converges in one or two iterations. Note that a hint can converge
+   * to a nearby local minimum instead of the global one.
+   *
+   * @param  ip   The point to project onto the spline.
+   * @param  hint Optional. The value of t to start the search from.
+   * @return The value of t, the closest point, and the signed distance to the point.
+   */
+  constexpr Projection project(const Vector& ip, std::optional<double> hint = std::nullopt) const {
+    double t = hint ? std::clamp(hint.value(), 0.0, 1.0) : seed(ip);
+    for (size_t i = 0; i < 8; ++i) {
+      // minimize the squared distance, whose derivative is diff . d
+      Vector diff = calc(t).vector() - ip;
+      Vector d = calc_d(t);
+      Vector d2 = calc_d2(t);
+      double f = dot(diff, d);
+      double df = dot(d, d) + dot(diff, d2);
+      if (df <= 0) { break; }
+      double next = std::clamp(t - f / df, 0.0, 1.0);
+      bool done = std::abs(next - t) < 1e-9;
+      t = next;
+      if (done) { break; }
+    }
+
+    Vector point = calc(t).vector();
+    Vector d = calc_d(t);
+    Vector diff = ip - point;
+    double cross = d.x.convert(meter) * diff.y.convert(meter) -
+                   d.y.convert(meter) * diff.x.convert(meter);
+    QLength dist = point.distTo(ip);
+    return {t, point, cross < 0 ? -dist : dist};
+  }
+
   /**
    * Calculate the length of the spline. This method has a default implementation that tries to fit
    * lines onto the spline and sums their length.
@@ -55,9 +205,23 @@ public:
     return len;
   }
 
+  /**
+   * Calculate the length of the spline by integrating its velocity. This method has a default
+   * implementation that uses adaptive Gauss–Legendre quadrature, which only subdivides the spline
+   * where it is needed to reach the desired tolerance.
+   *
+   * @param  tolerance The maximum error of the calculated length.
+   * @return The length of the spline.
+   */
+  constexpr virtual QLength arc_length(const QLength& tolerance = 0.1_mm) const {
+    auto f = [&](double t) { return velocity(t).abs().convert(meter); };
+    return util::integrate(f, 0.0, 1.0, tolerance.convert(meter)) * meter;
+  }
+
   /**
    * Using the velocity of the spline, calculate how much to increment t to travel a certain
-   * distance.
+   * distance. This is a first-order estimate which drifts when the velocity changes quickly, so
+   * prefer a LengthTable when stepping through the whole spline.
    *
    * @param  t    The previous value of t.
    * @param  dist The desired distance to travel.
@@ -66,12 +230,57 @@ public:
   constexpr virtual double t_at_dist_travelled(double t, const QLength& dist) const {
     return t + (dist / velocity(t).abs()).convert(number);
   }
+
+protected:
+  /**
+   * The dot product of two vectors, in square meters.
+   */
+  static constexpr double dot(const Vector& a, const Vector& b) {
+    return (a.x * b.x + a.y * b.y).convert(meter2);
+  }
+
+  /**
+   * Find which of a few evenly spaced samples is closest to a point, used to start a projection.
+   */
+  constexpr double seed(const Vector& ip) const {
+    constexpr size_t samples = 16;
+    double best = 0;
+    QLength bestDist {std::numeric_limits<double>::infinity()};
+    for (size_t i = 0; i <= samples; ++i) {
+      double t = static_cast<double>(i) / samples;
+      QLength dist = calc(t).distTo(ip);
+      if (dist < bestDist) {
+        best = t;
+        bestDist = dist;
+      }
+    }
+    return best;
+  }
+
+  /**
+   * The number of samples that splines process at a time in the batch methods, which is small
+   * enough for the intermediate buffers to live on the stack.
+   */
+  static constexpr size_t batch_size = 64;
+
+  /**
+   * Make sure the output of a batch method can hold a sample for every t.
+   */
+  static constexpr void check_batch(size_t in, size_t out) {
+    if (out < in) { throw std::invalid_argument("Spline: batch output is smaller than input"); }
+  }
 };
 
+// forward declaration of the axes used by SplineHelper::mirrored, see view.hpp
+enum class Axis;
+
 /**
  * Provides some additional spline methods that require knowledge of the derived class type. This is
  * solved using a CRTP. All splines should inherit from this class rather than Spline.
  *
+ * Splines that nothing inherits from are marked `final`. A call through the concrete type, such as
+ * in the templated generators, is then bound statically instead of going through the vtable.
+ *
  * @tparam CRTP The derived class type.
  */
 template <class CRTP> class SplineHelper : public Spline {
@@ -90,14 +299,126 @@ public:
    * Generate the spline given a StepBy. Generate means to sample the whole spline and return an
    * array of points.
    */
-  template <class S> auto generate(S&& s) const& {
-    return Stepper<CRTP, std::reference_wrapper<CRTP>, S>(static_cast<const CRTP&>(*this),
-                                                          std::forward<S>(s))
-      .generate();
-  }
+  template <class S> auto generate(S&& s) const& { return step(std::forward<S>(s)).generate(); }
   template <class S> auto generate(S&& s) && {
     return Stepper<CRTP, CRTP, S>(static_cast<CRTP&&>(*this), std::forward<S>(s)).generate();
   }
+
+  /**
+   * Generate the spline at compile time, sampling it the same way as `StepBy::Count(N)`. This
+   * allows a fixed path to be stored as a constant array, so it takes no time or memory to create
+   * when the program starts. For example, `constexpr auto path = CubicBezier(...).generate<100>();`
+   *
+   * @tparam N How many points to sample across the spline. There will be one additional point.
+   * @return The array of points.
+   */
+  template <size_t N> consteval std::array<State, N + 1> generate() const {
+    static_assert(N > 0, "SplineHelper::generate: count must be greater than zero");
+    std::array<State, N + 1> out;
+    for (size_t i = 0; i <= N; ++i) {
+      out[i] = this->calc(static_cast<double>(i) / N);
+    }
+    return out;
+  }
+
+  /**
+   * Return a view of the spline which is travelled backwards, mirrored across an axis, or rotated
+   * and moved. Views of an lvalue contain a reference to the spline, and views of an rvalue contain
+   * the spline itself. See view.hpp.
+   *
+   * @param iaxis      The axis to mirror the spline across.
+   * @param itransform The offset to move the spline by, and the angle to rotate it by.
+   */
+  constexpr auto reversed() const&;
+  constexpr auto reversed() &&;
+  constexpr auto mirrored(Axis iaxis) const&;
+  constexpr auto mirrored(Axis iaxis) &&;
+  constexpr auto transformed(const State& itransform) const&;
+  constexpr auto transformed(const State& itransform) &&;
+
+  /**
+   * Build a LengthTable which maps between `t` and the distance travelled along the spline.
+   *
+   * @param resolution The number of intervals to divide the spline into.
+   */
+  auto table(size_t resolution = 100) const {
+    return LengthTable(static_cast<const CRTP&>(*this), resolution);
+  }
+
+  /**
+   * Calculate the length of the spline using `length` or `arc_length`, but only the first time it
+   * is needed for a given resolution or tolerance. The result is cached in the spline, and the
+   * cache can safely be shared between tasks.
+   */
+  constexpr QLength cached_length(double resolution = 50) const {
+    return length_memo.get(resolution, [&] { return this->length(resolution); });
+  }
+  constexpr QLength cached_arc_length(const QLength& tolerance = 0.1_mm) const {
+    return arc_length_memo.get(tolerance, [&] { return this->arc_length(tolerance); });
+  }
+
+  /**
+   * Find the largest magnitude of curvature along the spline by sampling it. The result is cached
+   * in the spline.
+   *
+   * @param resolution The number of intervals to divide the spline into.
+   */
+  QCurvature max_curvature(size_t resolution = 100) const {
+    return curvature_memo.get(resolution, [&] {
+      std::vector<double> ts = samples(resolution);
+      std::vector<QCurvature> curvatures(ts.size());
+      this->curvature_batch(ts, curvatures);
+      return std::ranges::max(curvatures, {}, [](const QCurvature& k) { return k.abs(); }).abs();
+    });
+  }
+
+  /**
+   * Find the bottom left and top right corners of the box containing the spline by sampling it.
+   * The result is cached in the spline.
+   *
+   * @param resolution The number of intervals to divide the spline into.
+   */
+  std::pair<Vector, Vector> bounds(size_t resolution = 100) const {
+    return bounds_memo.get(resolution, [&] {
+      std::vector<double> ts = samples(resolution);
+      std::vector<State> points(ts.size());
+      this->calc_batch(ts, points);
+      auto [x_min, x_max] = std::ranges::minmax(points, {}, &Vector::x);
+      auto [y_min, y_max] = std::ranges::minmax(points, {}, &Vector::y);
+      return std::make_pair(Vector(x_min.x, y_min.y), Vector(x_max.x, y_max.y));
+    });
+  }
+
+protected:
+  /**
+   * Divide t into evenly spaced samples, including both ends.
+   */
+  static std::vector<double> samples(size_t resolution) {
+    std::vector<double> ts(resolution + 1);
+    for (size_t i = 0; i <= resolution; ++i) {
+      ts[i] = static_cast<double>(i) / resolution;
+    }
+    return ts;
+  }
+
+  /**
+   * Empty the caches. Splines which can be modified after they are created must call this whenever
+   * they change.
+   */
+  constexpr void invalidate() {
+    length_memo.clear();
+    arc_length_memo.clear();
+    curvature_memo.clear();
+    bounds_memo.clear();
+  }
+
+  util::Memo<double, QLength> length_memo;
+  util::Memo<QLength, QLength> arc_length_memo;
+  util::Memo<size_t, QCurvature> curvature_memo;
+  util::Memo<size_t, std::pair<Vector, Vector>> bounds_memo;
 };
 
 } // namespace lib7842
+
+// the views are splines themselves, so they are defined after SplineHelper
+#include "view.hpp"
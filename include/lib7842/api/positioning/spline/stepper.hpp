@@ -1,23 +1,31 @@
 #pragma once
+#include "lengthTable.hpp"
 #include "lib7842/api/positioning/point/state.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <memory>
+#include <ranges>
 
 namespace lib7842 {
 
 /**
- * A Stepper is a class that behaves like a container by providing begin and end methods. These
- * methods produce iterators which sample a spline according to some strategy. This gives the user a
- * way to expressively control how a spline is traversed and lazily defer spline calculation until
- * needed.
+ * A Stepper is a lazy range of the points along a spline. Its iterators sample the spline according
+ * to some strategy, and iteration ends at a `std::default_sentinel`. This gives the user a way to
+ * expressively control how a spline is traversed and lazily defer spline calculation until needed.
+ * A Stepper models `std::ranges::forward_range`, so it can be piped through range adaptors such as
+ * `std::views::transform` without creating an intermediate array.
  *
  * A Stepper contains a spline and a sampler. The spline is contained by value or reference
  * depending on how it was passed to the Stepper constructor. A sampler is helper class which
  * describes how to step through the spline. There are a few samplers available in the `StepBy`
- * namespace: `Count` (how many steps from start to end), `T` (the increment in t from 0 to 1), and
- * `Dist` (the increment in distance).
+ * namespace: `Count` (how many steps from start to end), `T` (the increment in t from 0 to 1),
+ * `Dist` (the increment in distance), and `Adaptive` (the increment in distance according to the
+ * curvature).
  *
  * There are a few ways to use this class:
- * - If you want a Stepper to use as an iterator (for example, with a for-each loop or stl
- *   algorithm), you can either use the Stepper constructor or `Spline::step`.
+ * - If you want a Stepper to use as a range (for example, with a for-each loop, range algorithm,
+ *   or view), you can either use the Stepper constructor or `Spline::step`.
  * - If you want to simply produce an array of points, you can use the generate method of this class
  *   or directly use `Spline::generate`.
  *
@@ -27,7 +35,8 @@ namespace lib7842 {
  *           automatically set according to the class template deduction guide.
  * @tparam S The type of sampler.
  */
-template <class T, class U, class S> class Stepper {
+template <class T, class U, class S>
+class Stepper : public std::ranges::view_interface<Stepper<T, U, S>> {
 public:
   /**
    * Create a new Stepper given a spline and a sampler.
@@ -39,19 +48,33 @@ public:
     spline(std::forward<T>(ispline)), sampler(std::forward<S>(isampler)) {}
 
   /**
-   * Sample the entire spline according to the sampler, and return the resulting array of points.
+   * Sample the entire spline according to the sampler, and return the resulting array of points. If
+   * the sampler knows every `t` in advance, it generates the points using the batch methods of the
+   * spline.
    *
    * @return The array of points.
    */
-  auto generate() const { return std::vector<State>(begin(), end()); }
+  auto generate() const {
+    const T& ispline = spline;
+    if constexpr (requires { sampler.generate(ispline); }) {
+      return sampler.generate(ispline);
+    } else {
+      std::vector<State> out;
+      std::ranges::copy(*this, std::back_inserter(out));
+      return out;
+    }
+  }
 
   /**
-   * Container iterator methods. These return an iterator to the beginning and end of the spline.
+   * Range methods. The iterator directly samples the spline, and it knows when it has reached the
+   * end, so the end of the range is a `std::default_sentinel`.
    *
    * @return An S::iterator<T> which directly samples the spline.
    */
-  constexpr auto begin() const { return sampler.template begin<T>(spline); }
-  constexpr auto end() const { return sampler.template end<T>(spline); }
+  constexpr auto begin() const {
+    return sampler.template begin<std::remove_cvref_t<T>>(spline);
+  }
+  constexpr std::default_sentinel_t end() const { return {}; }
 
 protected:
   U spline;
@@ -70,6 +93,11 @@ Stepper(T&&, S&&)
 /**
  * This namespace provides a collection of samplers to be given to `Stepper(spline, sampler)`,
  * `Spline::step(sampler)`, or `Spline::generate(sampler)`.
+ *
+ * Each sampler provides a `begin` method which returns an iterator into the spline. The iterators
+ * are forward iterators which compare equal to `std::default_sentinel` once they have passed the
+ * end of the spline. Along with the point, they provide the current `t` and a full
+ * `Spline::Sample`.
  */
 namespace StepBy {
 
@@ -82,22 +110,34 @@ class Count {
   /**
    * This class is the internal iterator which does the work to step through and sample the spline.
    */
-  template <class T>
-  class iterator : public std::iterator<const std::forward_iterator_tag, State, size_t> {
+  template <class T> class iterator {
   public:
-    constexpr iterator(const T& ip, size_t ic, size_t ii) : p(ip), c(ic), i(ii) {}
-    constexpr bool operator!=(const iterator& rhs) const { return i != (rhs.i + 1); }
-    constexpr State operator*() const { return p.calc(static_cast<double>(i) / c); }
-    constexpr State operator->() const { return *(*this); }
+    using iterator_concept = std::forward_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = State;
+    using difference_type = std::ptrdiff_t;
+
+    constexpr iterator() = default;
+    constexpr iterator(const T& ip, size_t ic, size_t ii) : p(&ip), c(ic), i(ii) {}
+    constexpr bool operator==(const iterator& rhs) const { return i == rhs.i; }
+    constexpr bool operator==(std::default_sentinel_t) const { return i > c; }
+    constexpr State operator*() const { return p->calc(t()); }
+    constexpr auto sample() const { return p->evaluate(t()); }
+    constexpr double t() const { return static_cast<double>(i) / c; }
     constexpr iterator& operator++() {
       ++i;
       return *this;
     }
+    constexpr iterator operator++(int) {
+      auto it = *this;
+      ++*this;
+      return it;
+    }
 
   protected:
-    const T& p;
-    const size_t c;
-    size_t i;
+    const T* p {nullptr};
+    size_t c {0};
+    size_t i {0};
   };
 
 public:
@@ -112,8 +152,20 @@ public:
     ic > 0 ? true : throw std::invalid_argument("StepBy::Count: count must be greater than zero");
   }
   template <class T> constexpr auto begin(const T& ip) const { return iterator<T>(ip, c, 0); }
-  template <class T> constexpr auto end(const T& ip) const { return iterator<T>(ip, c, c); }
-  const size_t c;
+
+  /**
+   * Sample every point at once using the batch methods of the spline.
+   */
+  template <class T> auto generate(const T& ip) const {
+    std::vector<double> ts(c + 1);
+    for (size_t i = 0; i <= c; ++i) {
+      ts[i] = static_cast<double>(i) / c;
+    }
+    std::vector<State> out(ts.size());
+    ip.calc_batch(ts, out);
+    return out;
+  }
+  size_t c;
 };
 
 /**
@@ -137,31 +189,48 @@ consteval auto T(double it) {
 
 /**
  * A Dist is a sampler which samples points along a spline that have have constant spacing.
- * Internally it keeps track of t, and for every step it uses the `t_at_dist_travelled` method to
- * calculate how much to increase `t`. The sampler starts with `t` at 0 and ends when `t` is greater
- * than 1.0.
+ * Internally it builds a LengthTable of the spline when iteration begins, and for every step it
+ * increments the distance travelled and uses the table to find the corresponding `t`. The sampler
+ * starts at the beginning of the spline and ends when the distance is greater than the length of
+ * the spline.
  */
 class Dist {
-  template <class T>
-  class iterator : public std::iterator<const std::forward_iterator_tag, State, double> {
+  /**
+   * This class is the internal iterator which does the work to step through and sample the spline.
+   */
+  template <class T> class iterator {
   public:
-    /**
-     * This class is the internal iterator which does the work to step through and sample the
-     * spline.
-     */
-    constexpr iterator(const T& ip, const QLength& id, double it) : p(ip), d(id), t(it) {}
-    constexpr bool operator!=(const iterator& rhs) const { return static_cast<float>(t) <= rhs.t; }
-    constexpr State operator*() const { return p.calc(t); }
-    constexpr State operator->() const { return *(*this); }
-    constexpr iterator& operator++() {
-      t = p.t_at_dist_travelled(t, d);
+    using iterator_concept = std::forward_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = State;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+    iterator(const T& ip, std::shared_ptr<const LengthTable> itable, const QLength& id) :
+      p(&ip), table(std::move(itable)), d(id) {}
+    bool operator==(const iterator& rhs) const { return s == rhs.s; }
+    bool operator==(std::default_sentinel_t) const {
+      return static_cast<float>(s.convert(meter)) >
+             static_cast<float>(table->length().convert(meter));
+    }
+    State operator*() const { return p->calc(t()); }
+    auto sample() const { return p->evaluate(t()); }
+    double t() const { return table->t_at_length(s); }
+    iterator& operator++() {
+      s += d;
       return *this;
     }
+    iterator operator++(int) {
+      auto it = *this;
+      ++*this;
+      return it;
+    }
 
   protected:
-    const T& p;
-    const QLength d;
-    double t;
+    const T* p {nullptr};
+    std::shared_ptr<const LengthTable> table {nullptr};
+    QLength d {0_m};
+    QLength s {0_m};
   };
 
 public:
@@ -173,9 +242,99 @@ public:
   consteval explicit Dist(const QLength& id) : d(id) {
     id > 0_m ? true : throw std::invalid_argument("StepBy::Dist: dist must be greater than zero");
   }
-  template <class T> constexpr auto begin(const T& ip) const { return iterator<T>(ip, d, 0.0); }
-  template <class T> constexpr auto end(const T& ip) const { return iterator<T>(ip, d, 1.0); }
-  const QLength d;
+  template <class T> auto begin(const T& ip) const {
+    return iterator<T>(ip, std::make_shared<const LengthTable>(ip), d);
+  }
+  QLength d;
+};
+
+/**
+ * An Adaptive is a sampler which places points along a spline so that the straight lines between
+ * them stay within a certain distance of the spline. The error of a chord of length c across an
+ * arc with curvature k is about c^2 * k / 8, so the sampler takes long steps where the spline is
+ * straight and short steps where it turns, up to a maximum spacing. Like Dist, it builds a
+ * LengthTable of the spline when iteration begins. The first and last points are always the start
+ * and end of the spline.
+ */
+class Adaptive {
+  /**
+   * This class is the internal iterator which does the work to step through and sample the spline.
+   */
+  template <class T> class iterator {
+  public:
+    using iterator_concept = std::forward_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = State;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+    iterator(const T& ip, std::shared_ptr<const LengthTable> itable, const QLength& ie,
+             const QLength& imax) :
+      p(&ip), table(std::move(itable)), e(ie), max(imax) {}
+    bool operator==(const iterator& rhs) const { return s == rhs.s && done == rhs.done; }
+    bool operator==(std::default_sentinel_t) const { return done; }
+    State operator*() const { return p->calc(t()); }
+    auto sample() const { return p->evaluate(t()); }
+    double t() const { return table->t_at_length(s); }
+    iterator& operator++() {
+      if (s >= table->length()) {
+        done = true;
+        return *this;
+      }
+      // check the curvature at both ends of the step so that a turn is not skipped over
+      QLength ds = step(t());
+      ds = std::min(ds, step(table->t_at_length(s + ds)));
+      s = std::min(s + ds, table->length());
+      return *this;
+    }
+    iterator operator++(int) {
+      auto it = *this;
+      ++*this;
+      return it;
+    }
+
+  protected:
+    /**
+     * Find the longest step from t whose chord error is within the tolerance. The step is never
+     * shorter than the tolerance itself, so a cusp can't stall the sampler. At a cusp the curvature
+     * is undefined, so the shortest step is taken.
+     */
+    QLength step(double it) const {
+      double k = p->curvature(it).abs().convert(1 / meter);
+      if (!std::isfinite(k)) { return e; }
+      if (k == 0) { return max; }
+      QLength chord = std::sqrt(8.0 * e.convert(meter) / k) * meter;
+      return std::clamp(chord, e, max);
+    }
+
+    const T* p {nullptr};
+    std::shared_ptr<const LengthTable> table {nullptr};
+    QLength e {0_m};
+    QLength max {0_m};
+    QLength s {0_m};
+    bool done {false};
+  };
+
+public:
+  /**
+   * Create a new sampler that samples points according to the curvature of the spline.
+   *
+   * @param ie   The maximum distance between the spline and the lines connecting the points. Must
+   *             be positive and greater than zero.
+   * @param imax The maximum spacing between points, used where the spline is straight. Must be
+   *             greater than ie.
+   */
+  consteval Adaptive(const QLength& ie, const QLength& imax) : e(ie), max(imax) {
+    ie > 0_m ? true
+             : throw std::invalid_argument("StepBy::Adaptive: error must be greater than zero");
+    imax > ie ? true
+              : throw std::invalid_argument("StepBy::Adaptive: max must be greater than error");
+  }
+  template <class T> auto begin(const T& ip) const {
+    return iterator<T>(ip, std::make_shared<const LengthTable>(ip), e, max);
+  }
+  QLength e;
+  QLength max;
 };
 
 } // namespace StepBy
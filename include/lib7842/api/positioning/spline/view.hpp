@@ -0,0 +1,182 @@
+#pragma once
+#include "spline.hpp"
+#include <functional>
+#include <type_traits>
+
+namespace lib7842 {
+
+/**
+ * The base of the spline views, which wrap another spline and transform it as it is sampled. The
+ * spline is contained by value or reference, similar to a Stepper. Views of an lvalue only hold a
+ * reference, so one canonical path can serve every mirrored or shifted variant without copying it,
+ * and the cached length of the canonical path is shared by all of them.
+ *
+ * Views are created using `SplineHelper::reversed`, `mirrored`, and `transformed`, and can be
+ * chained. For example, `path.mirrored(Axis::y).transformed({12_ft, 0_ft, 0_deg})` is the path
+ * mirrored to the other side of a twelve foot field.
+ *
+ * @tparam CRTP The derived view type.
+ * @tparam S    The spline storage type. Either the spline, or `std::reference_wrapper` to it.
+ */
+template <class CRTP, class S> class SplineView : public SplineHelper<CRTP> {
+public:
+  constexpr explicit SplineView(S ispline) : spline(std::move(ispline)) {}
+
+  constexpr ~SplineView() override {}
+
+  /**
+   * None of the views change the length of the spline, so the length is taken from the cache of
+   * the wrapped spline.
+   */
+  constexpr QLength length(double resolution = 50) const override {
+    return base().cached_length(resolution);
+  }
+  constexpr QLength arc_length(const QLength& tolerance = 0.1_mm) const override {
+    return base().cached_arc_length(tolerance);
+  }
+
+protected:
+  S spline;
+
+  /**
+   * The wrapped spline.
+   */
+  constexpr const auto& base() const {
+    return static_cast<const std::unwrap_reference_t<S>&>(spline);
+  }
+};
+
+/**
+ * A view of a spline which is travelled from the end to the start. The heading is turned around,
+ * and since the spline now turns the other way, the curvature changes sign.
+ */
+template <class S> class Reversed final : public SplineView<Reversed<S>, S> {
+public:
+  constexpr explicit Reversed(S ispline) : SplineView<Reversed<S>, S>(std::move(ispline)) {}
+
+  constexpr ~Reversed() override {}
+
+  constexpr State calc(double t) const override {
+    State p = this->base().calc(1 - t);
+    return {p.vector(), p.theta + 180_deg};
+  }
+  constexpr Vector calc_d(double t) const override { return this->base().calc_d(1 - t) * -1; }
+  constexpr Vector calc_d2(double t) const override { return this->base().calc_d2(1 - t); }
+  constexpr QCurvature curvature(double t) const override {
+    return this->base().curvature(1 - t) * -1;
+  }
+  constexpr QLength velocity(double t) const override { return this->base().velocity(1 - t); }
+  constexpr Spline::Sample evaluate(double t) const override {
+    auto [state, vel, k] = this->base().evaluate(1 - t);
+    return {{state.vector(), state.theta + 180_deg}, vel, k * -1};
+  }
+};
+
+/**
+ * The axes that a spline can be mirrored across. Mirroring across the x axis negates y, and
+ * mirroring across the y axis negates x.
+ */
+enum class Axis { x, y };
+
+/**
+ * A view of a spline which is mirrored across an axis. A mirrored spline turns the other way, so
+ * the curvature changes sign.
+ */
+template <class S> class Mirrored final : public SplineView<Mirrored<S>, S> {
+public:
+  constexpr Mirrored(S ispline, Axis iaxis) :
+    SplineView<Mirrored<S>, S>(std::move(ispline)), axis(iaxis) {}
+
+  constexpr ~Mirrored() override {}
+
+  constexpr State calc(double t) const override { return mirror(this->base().calc(t)); }
+  constexpr Vector calc_d(double t) const override { return mirror(this->base().calc_d(t)); }
+  constexpr Vector calc_d2(double t) const override { return mirror(this->base().calc_d2(t)); }
+  constexpr QCurvature curvature(double t) const override {
+    return this->base().curvature(t) * -1;
+  }
+  constexpr QLength velocity(double t) const override { return this->base().velocity(t); }
+  constexpr Spline::Sample evaluate(double t) const override {
+    auto [state, vel, k] = this->base().evaluate(t);
+    return {mirror(state), vel, k * -1};
+  }
+
+protected:
+  Axis axis;
+
+  constexpr Vector mirror(const Vector& ip) const {
+    return axis == Axis::x ? Vector(ip.x, ip.y * -1) : Vector(ip.x * -1, ip.y);
+  }
+  constexpr State mirror(const State& ip) const {
+    return {mirror(ip.vector()), axis == Axis::x ? ip.theta * -1 : 180_deg - ip.theta};
+  }
+};
+
+/**
+ * A view of a spline which is rotated about the origin and then moved, such as to start the same
+ * path from a different tile. The rotation is found once when the view is created.
+ */
+template <class S> class Transformed final : public SplineView<Transformed<S>, S> {
+public:
+  /**
+   * @param ispline    The spline.
+   * @param itransform The offset to move the spline by, and the angle to rotate it by.
+   */
+  constexpr Transformed(S ispline, const State& itransform) :
+    SplineView<Transformed<S>, S>(std::move(ispline)),
+    offset(itransform.vector()),
+    angle(itransform.theta),
+    cos_r(cos(itransform.theta).convert(number)),
+    sin_r(sin(itransform.theta).convert(number)) {}
+
+  constexpr ~Transformed() override {}
+
+  constexpr State calc(double t) const override { return transform(this->base().calc(t)); }
+  constexpr Vector calc_d(double t) const override { return rotate(this->base().calc_d(t)); }
+  constexpr Vector calc_d2(double t) const override { return rotate(this->base().calc_d2(t)); }
+  constexpr QCurvature curvature(double t) const override { return this->base().curvature(t); }
+  constexpr QLength velocity(double t) const override { return this->base().velocity(t); }
+  constexpr Spline::Sample evaluate(double t) const override {
+    auto sample = this->base().evaluate(t);
+    sample.state = transform(sample.state);
+    return sample;
+  }
+
+protected:
+  Vector offset;
+  QAngle angle;
+  double cos_r;
+  double sin_r;
+
+  constexpr Vector rotate(const Vector& ip) const {
+    return {ip.x * cos_r - ip.y * sin_r, ip.x * sin_r + ip.y * cos_r};
+  }
+  constexpr State transform(const State& ip) const {
+    return {offset + rotate(ip.vector()), ip.theta + angle};
+  }
+};
+
+/**
+ * The view methods of SplineHelper, which are defined here since the views are splines themselves.
+ */
+template <class CRTP> constexpr auto SplineHelper<CRTP>::reversed() const& {
+  return Reversed(std::cref(static_cast<const CRTP&>(*this)));
+}
+template <class CRTP> constexpr auto SplineHelper<CRTP>::reversed() && {
+  return Reversed(static_cast<CRTP&&>(*this));
+}
+template <class CRTP> constexpr auto SplineHelper<CRTP>::mirrored(Axis iaxis) const& {
+  return Mirrored(std::cref(static_cast<const CRTP&>(*this)), iaxis);
+}
+template <class CRTP> constexpr auto SplineHelper<CRTP>::mirrored(Axis iaxis) && {
+  return Mirrored(static_cast<CRTP&&>(*this), iaxis);
+}
+template <class CRTP>
+constexpr auto SplineHelper<CRTP>::transformed(const State& itransform) const& {
+  return Transformed(std::cref(static_cast<const CRTP&>(*this)), itransform);
+}
+template <class CRTP> constexpr auto SplineHelper<CRTP>::transformed(const State& itransform) && {
+  return Transformed(static_cast<CRTP&&>(*this), itransform);
+}
+
+} // namespace lib7842
@@ -3,17 +3,66 @@
 #include "lib7842/api/positioning/spline/stepper.hpp"
 #include "pursuitLimits.hpp"
 #include "waypoint.hpp"
+#include <array>
+#include <ranges>
+#include <span>
 
 namespace lib7842 {
 
 class PathGenerator {
 public:
   /**
-   * Generate a PursuitPath containing waypoint information for pure pursuit, given a Stepper.
+   * Generate a PursuitPath containing waypoint information for pure pursuit, given a range of
+   * points such as a Stepper or a view of one. If the range iterates a spline directly, the
+   * position and curvature of each waypoint are found in a single evaluation of the spline, so the
+   * curvature is exact instead of being estimated from neighbouring points.
    */
-  template <class T, class U, class S>
-  static std::vector<Waypoint> generate(const Stepper<T, U, S>& ip, const PursuitLimits& limits) {
-    return generate(ip.generate(), limits);
+  template <std::ranges::input_range R>
+  requires std::convertible_to<std::ranges::range_value_t<R>, State>
+  static std::vector<Waypoint> generate(R&& ip, const PursuitLimits& limits) {
+    std::vector<Waypoint> path;
+    auto it = std::ranges::begin(ip);
+    if constexpr (requires { it.sample(); }) {
+      for (; it != std::ranges::end(ip); ++it) {
+        auto sample = it.sample();
+        // waypoint curvatures are stored squared, see calculateCurvature
+        double curvature = sample.curvature.convert(1 / meter);
+        path.emplace_back(sample.state).curvature = curvature * curvature / meter;
+      }
+    } else {
+      for (; it != std::ranges::end(ip); ++it) {
+        path.emplace_back(State(*it));
+      }
+      setCurvatures(path);
+    }
+    setVelocity(path, limits);
+    return path;
+  }
+
+  /**
+   * Generate a PursuitPath containing waypoint information for pure pursuit at compile time. The
+   * spline is sampled the same way as `StepBy::Count(N)`. This allows a fixed path to be stored as
+   * a constant array, so it takes no time or memory to create when the program starts.
+   *
+   * @tparam N      How many points to sample across the spline. There will be one additional point.
+   * @param  spline The spline
+   * @param  limits The pure pursuit limits
+   * @return the generated path
+   */
+  template <size_t N, class T>
+  static consteval std::array<Waypoint, N + 1> generate(const T& spline,
+                                                        const PursuitLimits& limits) {
+    static_assert(N > 0, "PathGenerator::generate: count must be greater than zero");
+    std::array<Waypoint, N + 1> path;
+    for (size_t i = 0; i <= N; ++i) {
+      auto sample = spline.evaluate(static_cast<double>(i) / N);
+      // waypoint curvatures are stored squared, see calculateCurvature
+      double curvature = sample.curvature.convert(1 / meter);
+      path[i] = Waypoint(sample.state);
+      path[i].curvature = curvature * curvature / meter;
+    }
+    setVelocity(path, limits);
+    return path;
   }
 
   /**
@@ -48,7 +97,31 @@ protected:
    * @param ipath  The path
    * @param limits The pure pursuit limits
    */
-  static void setVelocity(std::vector<Waypoint>& ipath, const PursuitLimits& limits);
+  static constexpr void setVelocity(std::span<Waypoint> ipath, const PursuitLimits& limits) {
+    ipath.back().velocity = limits.finalVel;
+    for (size_t i = ipath.size() - 1; i > 0; i--) {
+      auto& start = ipath[i];
+      auto& end = ipath[i - 1];
+
+      // k / curvature, limited to max
+      double curvature = ipath[i].curvature.convert(1 / meter);
+      QSpeed wantedVel = limits.k && curvature > 0
+                           ? std::min(limits.maxVel, limits.k.value() / curvature)
+                           : limits.maxVel;
+
+      // distance from last point
+      double distance = start.distTo(end).convert(meter);
+
+      // maximum velocity given distance respecting acceleration
+      // vf = sqrt(vi2 + 2ad)
+      QSpeed maxIncrement = mps * std::sqrt(std::pow(start.velocity.convert(mps), 2) +
+                                            (2.0 * limits.decel.convert(mps2) * distance));
+
+      // limiting to maximum accelerated velocity
+      QSpeed newVel = std::min(wantedVel, maxIncrement);
+      end.velocity = newVel;
+    }
+  }
 
   /**
    * Gets the curvature of a given segment.
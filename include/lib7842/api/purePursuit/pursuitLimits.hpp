@@ -1,7 +1,9 @@
 #pragma once
 #include "okapi/api/units/QAcceleration.hpp"
 #include "okapi/api/units/QAngularSpeed.hpp"
+#include "okapi/api/units/QLength.hpp"
 #include "okapi/api/units/QSpeed.hpp"
+#include "okapi/api/units/QTime.hpp"
 #include <optional>
 
 namespace lib7842 {
@@ -35,9 +37,10 @@ struct PursuitLimits {
    *                  limited by this value divided by the path curvature. A higher curvature means
    *                  a lower velocity.
    */
-  PursuitLimits(const QSpeed& iminVel, const QAcceleration& iaccel, const QSpeed& imaxVel,
-                const QAcceleration& idecel, const QSpeed& ifinalVel,
-                const std::optional<QSpeed>& ik = std::nullopt);
+  constexpr PursuitLimits(const QSpeed& iminVel, const QAcceleration& iaccel,
+                          const QSpeed& imaxVel, const QAcceleration& idecel,
+                          const QSpeed& ifinalVel, const std::optional<QSpeed>& ik = std::nullopt) :
+    minVel(iminVel), accel(iaccel), maxVel(imaxVel), decel(idecel), finalVel(ifinalVel), k(ik) {}
   /**
    * Real-world units. Deceleration and final velocity is inferred from acceleration and minimum
    * velocity.
@@ -49,8 +52,9 @@ struct PursuitLimits {
    *                limited by this value divided by the path curvature. A higher curvature means a
    *                lower velocity.
    */
-  PursuitLimits(const QSpeed& iminVel, const QAcceleration& iaccel, const QSpeed& imaxVel,
-                const std::optional<QSpeed>& ik = std::nullopt);
+  constexpr PursuitLimits(const QSpeed& iminVel, const QAcceleration& iaccel,
+                          const QSpeed& imaxVel, const std::optional<QSpeed>& ik = std::nullopt) :
+    PursuitLimits(iminVel, iaccel, imaxVel, iaccel, iminVel, ik) {}
   /**
    * Real-world units. Time is used for acceleration and deceleration.
    *
@@ -64,9 +68,11 @@ struct PursuitLimits {
    *                  limited by this value divided by the path curvature. A higher curvature means
    *                  a lower velocity.
    */
-  PursuitLimits(const QSpeed& iminVel, const QTime& iaccel, const QSpeed& imaxVel,
-                const QTime& idecel, const QSpeed& ifinalVel,
-                const std::optional<QSpeed>& ik = std::nullopt);
+  constexpr PursuitLimits(const QSpeed& iminVel, const QTime& iaccel, const QSpeed& imaxVel,
+                          const QTime& idecel, const QSpeed& ifinalVel,
+                          const std::optional<QSpeed>& ik = std::nullopt) :
+    PursuitLimits(iminVel, (imaxVel - iminVel) / iaccel, imaxVel, (imaxVel - ifinalVel) / idecel,
+                  ifinalVel, ik) {}
 
   /**
    * Real-world units. Time is used for acceleration. Deceleration and final velocity is inferred
@@ -79,8 +85,9 @@ struct PursuitLimits {
    *                limited by this value divided by the path curvature. A higher curvature means a
    *                lower velocity.
    */
-  PursuitLimits(const QSpeed& iminVel, const QTime& iaccel, const QSpeed& imaxVel,
-                const std::optional<QSpeed>& ik = std::nullopt);
+  constexpr PursuitLimits(const QSpeed& iminVel, const QTime& iaccel, const QSpeed& imaxVel,
+                          const std::optional<QSpeed>& ik = std::nullopt) :
+    PursuitLimits(iminVel, (imaxVel - iminVel) / iaccel, imaxVel, ik) {}
 
   /**
    * Motor percentages. Wheel dimensions and gearing are used to determine the limits. Time is used
@@ -98,9 +105,10 @@ struct PursuitLimits {
    *                   limited by this value divided by the path curvature. A higher curvature means
    *                   a lower velocity.
    */
-  PursuitLimits(const QLength& iwheelDiam, const QAngularSpeed& igearset, double imin,
-                const QTime& iaccel, double imax, const QTime& idecel, double ifinal,
-                const std::optional<QSpeed>& ik = std::nullopt);
+  constexpr PursuitLimits(const QLength& iwheelDiam, const QAngularSpeed& igearset, double imin,
+                          const QTime& iaccel, double imax, const QTime& idecel, double ifinal,
+                          const std::optional<QSpeed>& ik = std::nullopt) :
+    PursuitLimits(iwheelDiam * igearset / radian, imin, iaccel, imax, idecel, ifinal, ik) {}
 
   /**
    * Motor percentages. Wheel dimensions and gearing are used to determine the limits. Time is used
@@ -117,8 +125,10 @@ struct PursuitLimits {
    *                   limited by this value divided by the path curvature. A higher curvature means
    *                   a lower velocity.
    */
-  PursuitLimits(const QLength& iwheelDiam, const QAngularSpeed& igearset, double imin,
-                const QTime& iaccel, double imax, const std::optional<QSpeed>& ik = std::nullopt);
+  constexpr PursuitLimits(const QLength& iwheelDiam, const QAngularSpeed& igearset, double imin,
+                          const QTime& iaccel, double imax,
+                          const std::optional<QSpeed>& ik = std::nullopt) :
+    PursuitLimits(iwheelDiam, igearset, imin, iaccel, imax, iaccel, imin, ik) {}
 
   /**
    * Motor percentages. The robot's top speed is used to determine the limits. Time is used for
@@ -135,8 +145,10 @@ struct PursuitLimits {
    *                  limited by this value divided by the path curvature. A higher curvature means
    *                  a lower velocity.
    */
-  PursuitLimits(const QSpeed& itopSpeed, double imin, const QTime& iaccel, double imax,
-                const QTime& idecel, double ifinal, const std::optional<QSpeed>& ik = std::nullopt);
+  constexpr PursuitLimits(const QSpeed& itopSpeed, double imin, const QTime& iaccel, double imax,
+                          const QTime& idecel, double ifinal,
+                          const std::optional<QSpeed>& ik = std::nullopt) :
+    PursuitLimits(itopSpeed * imin, iaccel, itopSpeed * imax, idecel, itopSpeed * ifinal, ik) {}
 
   /**
    * Motor percentages. The robot's top speed is used to determine the limits. Time is used for
@@ -151,8 +163,9 @@ struct PursuitLimits {
    *                  limited by this value divided by the path curvature. A higher curvature means
    *                  a lower velocity.
    */
-  PursuitLimits(const QSpeed& itopSpeed, double imin, const QTime& iaccel, double imax,
-                const std::optional<QSpeed>& ik = std::nullopt);
+  constexpr PursuitLimits(const QSpeed& itopSpeed, double imin, const QTime& iaccel, double imax,
+                          const std::optional<QSpeed>& ik = std::nullopt) :
+    PursuitLimits(itopSpeed, imin, iaccel, imax, iaccel, imin, ik) {}
 
   /**
    * The minimum velocity through the entire path.
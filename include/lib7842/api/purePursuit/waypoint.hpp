@@ -9,6 +9,7 @@ struct Waypoint : public State {
   QSpeed velocity {0_mps};
 
   using State::State;
+  constexpr Waypoint() = default;
   constexpr Waypoint(const QLength& ix, const QLength& iy) : State(ix, iy, 0_deg) {}
   constexpr explicit Waypoint(const State& ipoint) : State(ipoint) {};
 };
@@ -1,11 +1,17 @@
 #pragma once
+#include "lib7842/api/other/global.hpp"
 #include "lib7842/api/other/units.hpp"
 #include "lib7842/api/other/utility.hpp"
 #include "lib7842/api/positioning/point/state.hpp"
 #include "lib7842/api/positioning/spline/spline.hpp"
 #include "lib7842/api/trajectory/profile/limits.hpp"
 #include "lib7842/api/trajectory/profile/piecewise_trapezoidal.hpp"
+#include "lib7842/api/trajectory/profile/time_optimal.hpp"
 #include "okapi/impl/util/rate.hpp"
+#include <concepts>
+#include <span>
+#include <variant>
+#include <vector>
 
 namespace lib7842 {
 
@@ -20,8 +26,65 @@ public:
                                        const Profile<>::Flags& flags = {},
                                        const PiecewiseTrapezoidal::Markers& markers = {});
 
+  // same as above, but keeps the concrete type of the spline and runner so that the calls made
+  // every timeslice can be inlined instead of going through virtual calls and a std::function. P is
+  // the type of profile between each marker, such as Trapezoidal<> or SCurve<>.
+  template <class P = Trapezoidal<>, class S, class R>
+  static PiecewiseProfile<P> generate(const Limits<>& limits, const R& runner, const S& spline,
+                                      const QTime& dt = 10_ms, const Profile<>::Flags& flags = {},
+                                      const PiecewiseTrapezoidal::Markers& markers = {}) {
+    auto rate = global::getTimeUtil()->getRate();
+    // map distance along the spline to t
+    LengthTable table(spline);
+    PiecewiseProfile<P> profile(limits, table.length(), flags, markers);
+    iterate(profile, table, runner, dt, [&] {
+#ifndef THREADS_STD
+      rate->delayUntil(dt);
+#endif
+    });
+    return profile;
+  }
+
+  // same as generate, but runs every timeslice immediately instead of waiting for each one. The
+  // runner is used to record the motion ahead of time, so it can be executed later.
+  static PiecewiseTrapezoidal plan(const Limits<>& limits, const Runner& runner,
+                                   const Spline& spline, const QTime& dt = 10_ms,
+                                   const Profile<>::Flags& flags = {},
+                                   const PiecewiseTrapezoidal::Markers& markers = {});
+
+  // same as above, but keeps the concrete type of the spline and runner
+  template <class P = Trapezoidal<>, class S, class R>
+  static PiecewiseProfile<P> plan(const Limits<>& limits, const R& runner, const S& spline,
+                                  const QTime& dt = 10_ms, const Profile<>::Flags& flags = {},
+                                  const PiecewiseTrapezoidal::Markers& markers = {}) {
+    LengthTable table(spline);
+    PiecewiseProfile<P> profile(limits, table.length(), flags, markers);
+    iterate(profile, table, runner, dt, [] {});
+    return profile;
+  }
+
+  // same as above, but follows a profile which has already been made for the spline, such as a
+  // TimeOptimal profile
+  template <class P, class S, class R>
+  requires std::derived_from<P, Profile<>>
+  static void plan(const P& profile, const R& runner, const S& spline, const QTime& dt = 10_ms) {
+    plan(profile, LengthTable(spline), runner, dt);
+  }
+
+  // same as above, but uses a length table which has already been built for the spline, such as
+  // the one kept by a TimeOptimal profile
+  template <class P, class R>
+  requires std::derived_from<P, Profile<>>
+  static void plan(const P& profile, const LengthTable& table, const R& runner,
+                   const QTime& dt = 10_ms) {
+    iterate(profile, table, runner, dt, [] {});
+  }
+
   // convert wheel velocity to wheel percentage
-  static Number toWheel(const QSpeed& v, const ChassisScales& scales, const QAngularSpeed& gearset);
+  static Number toWheel(const QSpeed& v, const ChassisScales& scales,
+                        const QAngularSpeed& gearset) {
+    return (v / (1_pi * scales.wheelDiameter * gearset)) * 360_deg;
+  }
 
   struct Step {
     State p;
@@ -35,10 +98,95 @@ public:
     double rightBack {0};
   };
 
+  // the profile that a generator planned a motion with. It holds the profile by value, and has the
+  // same methods as a profile, so it can be used as one. Use std::get to find the concrete type.
+  class Motion : public std::variant<PiecewiseTrapezoidal, PiecewiseSCurve, TimeOptimal> {
+  public:
+    using variant::variant;
+
+    Profile<>::State calc(QTime t) const {
+      return std::visit([&](auto&& profile) { return profile.calc(t); }, base());
+    }
+    Profile<>::State calc(QLength d) const {
+      return std::visit([&](auto&& profile) { return profile.calc(d); }, base());
+    }
+    Profile<>::State begin() const {
+      return std::visit([](auto&& profile) { return profile.begin(); }, base());
+    }
+    Profile<>::State end() const {
+      return std::visit([](auto&& profile) { return profile.end(); }, base());
+    }
+
+  protected:
+    const variant& base() const { return *this; }
+  };
+
+  // a motion that has been planned ahead of time, which contains the wheel setpoints of every
+  // timeslice. Executing it only needs to send each step to the motors.
+  struct Trajectory {
+    Motion profile;
+    QTime dt;
+    std::vector<Step> steps;
+  };
+
+  // replay a list of steps, giving each step to the actuator at the start of its timeslice
+  template <class A>
+  static void execute(std::span<const Step> steps, [[maybe_unused]] const QTime& dt,
+                      const A& actuator) {
+#ifndef THREADS_STD
+    auto rate = global::getTimeUtil()->getRate();
+#endif
+    for (size_t i = 0; i < steps.size(); ++i) {
+#ifndef THREADS_STD
+      if (i > 0) { rate->delayUntil(dt); }
+#endif
+      actuator(steps[i]);
+    }
+  }
+
 #ifdef THREADS_STD
-  using Output = std::pair<PiecewiseTrapezoidal, std::vector<Step>>;
+  using Output = std::pair<Motion, std::vector<Step>>;
 #else
-  using Output = PiecewiseTrapezoidal;
+  using Output = Motion;
 #endif
+
+protected:
+  // step along the spline one timeslice at a time, calling the runner and then the delay
+  template <class P, class R, class D>
+  static void iterate(const P& profile, const LengthTable& table, const R& runner,
+                      const QTime& dt, const D& delay) {
+    QLength length = table.length();
+    // the distance only increases, so use a cursor to sample the profile if it has one
+    auto&& sampler = [&]() -> decltype(auto) {
+      if constexpr (requires { profile.cursor(); }) {
+        return profile.cursor();
+      } else {
+        return (profile);
+      }
+    }();
+
+    // setup
+    double t = 0;
+    QLength dist = 0_m;
+    Profile<>::State k = profile.begin();
+    if (k.v == 0_mps) { k = sampler.calc(dt); }
+
+    while (dist <= length && t <= 1) {
+      // calculate and run motion along trajectory
+      runner(t, k);
+
+      // calculate distance traveled
+      QLength d_dist = k.v * dt;
+      dist += d_dist;
+      // calculate where along the spline we will be at the end of the timeslice
+      t = table.t_at_length(dist);
+      // calculate new velocity
+      k = sampler.calc(dist);
+
+      delay();
+    }
+    Profile<>::State end = profile.end();
+    if (end.v == 0_mps) { runner(1, end); }
+  }
 };
 } // namespace lib7842
@@ -1,35 +1,138 @@
 #pragma once
 #include "generator.hpp"
+#include <optional>
+#include <stdexcept>
 
 namespace lib7842 {
 
+// options for planning the speed with a TimeOptimal profile instead of a PiecewiseTrapezoidal, so
+// the robot slows down before each turn instead of during it
+// it is intended to be used with C++20 designated initializers
+struct TimeOptimalOptions {
+  std::optional<QAcceleration> centripetal {std::nullopt}; // the max centripetal acceleration
+  QLength spacing {1_cm}; // the distance between the samples of the path
+};
+
 class SkidSteerGenerator {
 public:
   virtual ~SkidSteerGenerator() = default;
 
   SkidSteerGenerator(std::shared_ptr<ChassisModel> imodel, const QAngularSpeed& igearset,
                      const ChassisScales& iscales, const Limits<>& ilimits, const QTime& idt,
-                     bool iisXdrive = false) :
+                     bool iisXdrive = false,
+                     const std::optional<TimeOptimalOptions>& itimeOptimal = std::nullopt) :
     model(std::move(imodel)),
     gearset(igearset),
     scales(iscales),
     limits(ilimits),
     dt(idt),
-    isXdrive(iisXdrive) {
+    isXdrive(iisXdrive),
+    timeOptimal(itimeOptimal) {
     if (isXdrive) { limits.v *= std::sqrt(2); }
+    if (timeOptimal && limits.j != Limits<>::Jerk {0.0}) {
+      throw std::invalid_argument("SkidSteerGenerator: TimeOptimal can't limit the jerk");
+    }
   };
 
   Generator::Output follow(const Spline& spline, bool forward = true,
                            const Profile<>::Flags& flags = {},
                            const PiecewiseTrapezoidal::Markers& markers = {});
 
+  // same as above, but keeps the concrete type of the spline so the spline can be inlined
+  template <class S>
+  Generator::Output follow(const S& spline, bool forward = true,
+                           const Profile<>::Flags& flags = {},
+                           const PiecewiseTrapezoidal::Markers& markers = {}) {
+    auto trajectory = plan(spline, forward, flags, markers);
+    execute(trajectory);
+
+#ifdef THREADS_STD
+    return std::make_pair(trajectory.profile, std::move(trajectory.steps));
+#else
+    return trajectory.profile;
+#endif
+  }
+
+  // calculate the whole motion ahead of time without moving the robot. The speed is planned by a
+  // TimeOptimal profile if the generator was given TimeOptimalOptions, otherwise by an SCurve
+  // between the markers if the limits have a jerk. The wheel setpoints of each step are the ones
+  // sent to the model, so they are swapped when driving backwards.
+  Generator::Trajectory plan(const Spline& spline, bool forward = true,
+                             const Profile<>::Flags& flags = {},
+                             const PiecewiseTrapezoidal::Markers& markers = {});
+
+  // same as above, but keeps the concrete type of the spline so the spline can be inlined
+  template <class S>
+  Generator::Trajectory plan(const S& spline, bool forward = true,
+                             const Profile<>::Flags& flags = {},
+                             const PiecewiseTrapezoidal::Markers& markers = {}) {
+    std::vector<Generator::Step> steps;
+    auto runner = [&](double t, Profile<>::State& k) {
+      steps.emplace_back(calc(spline.evaluate(t), k, forward));
+    };
+    if (timeOptimal) {
+      TimeOptimal profile(limits, spline, flags, markers, timeOptimal->centripetal,
+                          timeOptimal->spacing);
+      Generator::plan(profile, profile.table(), runner, dt);
+      return {std::move(profile), dt, std::move(steps)};
+    }
+    if (limits.j != Limits<>::Jerk {0.0}) {
+      auto profile = Generator::plan<SCurve<>>(limits, runner, spline, dt, flags, markers);
+      return {std::move(profile), dt, std::move(steps)};
+    }
+    auto profile = Generator::plan(limits, runner, spline, dt, flags, markers);
+    return {std::move(profile), dt, std::move(steps)};
+  }
+
+  // send a planned motion to the model, one step per timeslice
+  void execute(const Generator::Trajectory& trajectory);
+
+  // same as above, but for steps which are stored elsewhere, such as a TrajectoryFile. The robot is
+  // stopped first if the motion starts from rest.
+  void execute(std::span<const Generator::Step> steps, const QTime& idt,
+               const Number& start_v = 0_pct);
+
 protected:
+  // stop the robot if the motion starts from rest
+  void prepare(const Number& start_v);
+
+  // calculate the motion for one timeslice, given the sample of the spline
+  Generator::Step calc(const Spline::Sample& sample, Profile<>::State& k, bool forward) {
+    auto profiled_vel = k.v; // used for logging
+    auto curvature = sample.curvature;
+    // limit the velocity according to curvature, in case the curvature between the samples of the
+    // profile is higher. since this is passed by reference it will affect the generator code
+    k.v = std::min(k.v, limits.max_vel_at_curvature(curvature));
+
+    // angular speed is curvature times limited speed
+    QAngularSpeed w = curvature * k.v * radian;
+
+    // scale down motor speed if x drive
+    auto vel = k.v;
+    if (isXdrive) { vel /= std::sqrt(2); }
+
+    QSpeed left = vel - (w / radian * scales.wheelTrack) / 2;
+    QSpeed right = vel + (w / radian * scales.wheelTrack) / 2;
+
+    auto leftSpeed = Generator::toWheel(left, scales, gearset).convert(number);
+    auto rightSpeed = Generator::toWheel(right, scales, gearset).convert(number);
+
+    if (!forward) {
+      std::swap(leftSpeed, rightSpeed);
+      leftSpeed = -leftSpeed;
+      rightSpeed = -rightSpeed;
+    }
+
+    return {sample.state, k, w, curvature, profiled_vel, leftSpeed, rightSpeed};
+  }
+
   std::shared_ptr<ChassisModel> model;
   QAngularSpeed gearset;
   ChassisScales scales;
   Limits<> limits;
   QTime dt;
   bool isXdrive;
+  std::optional<TimeOptimalOptions> timeOptimal; // whether to plan with a TimeOptimal profile
 };
 
 } // namespace lib7842
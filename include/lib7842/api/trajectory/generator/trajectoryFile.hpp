@@ -0,0 +1,128 @@
+#pragma once
+#include "generator.hpp"
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+
+namespace lib7842 {
+
+/**
+ * A TrajectoryFile is a planned motion saved in a binary format, so that it can be planned offline
+ * on a computer and loaded when the robot starts instead of being planned again.
+ *
+ * The file is a header followed by every Generator::Step exactly as it is laid out in memory. When
+ * the file is loaded, the steps are used directly from the loaded bytes without being parsed or
+ * copied. On a computer the file is mapped into memory, and on the brain it is read from the SD
+ * card in a single read. Both are little endian with the same alignment of doubles, so a file
+ * saved on one can be loaded on the other. The header stores the version and the size of a step,
+ * so a file from an incompatible version of the library is rejected instead of misread.
+ *
+ * The header also keeps the dt, the limits, and the chassis scales that the motion was planned
+ * with, and a hash of the path, which can be compared against `TrajectoryFile::hash` to check that
+ * the file was planned from the current version of the path.
+ */
+class TrajectoryFile {
+public:
+  static constexpr uint32_t version = 1;
+  static constexpr std::array<char, 4> magic {'L', '7', 'T', 'J'};
+
+  struct Header {
+    std::array<char, 4> magic {}; // identifies the file
+    uint32_t version {0}; // the version of the format
+    uint32_t step_size {0}; // the size of each step in bytes
+    uint32_t reserved {0};
+    uint64_t count {0}; // the number of steps
+    uint64_t hash {0}; // the hash of the path that was planned, or zero
+    double dt {0}; // the length of each timeslice in seconds
+    double start_v {0}; // the starting velocity percentage
+    double a {0}; // the max acceleration in m/s^2
+    double v {0}; // the max velocity in m/s
+    double w {0}; // the max angular velocity in rad/s
+    double j {0}; // the max jerk in m/s^3
+    double wheel_diameter {0}; // in meters
+    double wheel_track {0}; // in meters
+  };
+
+  // the steps are read in place, so they must be plain data which directly follows the header
+  static_assert(std::is_trivially_copyable_v<Generator::Step>);
+  static_assert(sizeof(Header) % alignof(Generator::Step) == 0);
+
+  /**
+   * Load a file. The steps stay valid for as long as the TrajectoryFile exists.
+   *
+   * @param filename The file to load. On the brain, files on the SD card start with `/usd/`.
+   */
+  explicit TrajectoryFile(const std::string& filename);
+
+  TrajectoryFile(const TrajectoryFile&) = delete;
+  TrajectoryFile& operator=(const TrajectoryFile&) = delete;
+  ~TrajectoryFile();
+
+  /**
+   * Save a planned motion to a file.
+   *
+   * @param filename The file to write.
+   * @param steps    The steps of the motion.
+   * @param dt       The length of each timeslice.
+   * @param limits   The limits the motion was planned with.
+   * @param scales   The chassis scales the motion was planned with.
+   * @param start_v  The starting velocity percentage.
+   * @param hash     The hash of the path, or zero.
+   */
+  static void save(const std::string& filename, std::span<const Generator::Step> steps,
+                   const QTime& dt, const Limits<>& limits, const ChassisScales& scales,
+                   const Number& start_v = 0_pct, uint64_t hash = 0);
+
+  /**
+   * Save a motion returned by the `plan` method of a generator.
+   */
+  static void save(const std::string& filename, const Generator::Trajectory& trajectory,
+                   const Limits<>& limits, const ChassisScales& scales, uint64_t hash = 0);
+
+  /**
+   * Find a hash of a path by sampling it, which changes if the path is edited.
+   *
+   * @param  spline     The path.
+   * @param  resolution The number of intervals to sample.
+   * @return The 64-bit FNV-1a hash of the sampled states.
+   */
+  template <class S> static uint64_t hash(const S& spline, size_t resolution = 64) {
+    uint64_t h = 0xcbf29ce484222325;
+    for (size_t i = 0; i <= resolution; ++i) {
+      State p = spline.calc(static_cast<double>(i) / resolution);
+      for (double x : {p.x.convert(meter), p.y.convert(meter), p.theta.convert(radian)}) {
+        auto bits = std::bit_cast<uint64_t>(x);
+        for (size_t b = 0; b < 8; ++b) {
+          h = (h ^ ((bits >> (8 * b)) & 0xff)) * 0x100000001b3;
+        }
+      }
+    }
+    return h;
+  }
+
+  const Header& header() const { return *reinterpret_cast<const Header*>(data); }
+  std::span<const Generator::Step> steps() const {
+    return {reinterpret_cast<const Generator::Step*>(data + sizeof(Header)),
+            static_cast<size_t>(header().count)};
+  }
+
+  QTime dt() const { return header().dt * second; }
+  Number start_v() const { return header().start_v * number; }
+  Limits<> limits() const;
+
+protected:
+  const std::byte* data {nullptr}; // the contents of the file
+  size_t size {0}; // the size of the file in bytes
+#ifndef THREADS_STD
+  std::unique_ptr<std::byte[]> buffer {}; // the memory the file was read into
+#endif
+
+  // check that the contents are a valid file
+  void validate() const;
+};
+
+} // namespace lib7842
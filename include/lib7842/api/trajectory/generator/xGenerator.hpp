@@ -47,12 +47,112 @@ public:
     model(std::move(imodel)), gearset(igearset), scales(iscales), limits(ilimits), dt(idt) {
     limits.v *= std::sqrt(2);
     limits.a *= std::sqrt(2);
+    limits.j *= std::sqrt(2);
   };
 
   Generator::Output follow(const Spline& spline, const XFlags& flags = {},
                            const PiecewiseTrapezoidal::Markers& markers = {});
 
+  // same as above, but keeps the concrete type of the spline so the spline can be inlined
+  template <class S>
+  Generator::Output follow(const S& spline, const XFlags& flags = {},
+                           const PiecewiseTrapezoidal::Markers& markers = {}) {
+    auto trajectory = plan(spline, flags, markers);
+    execute(trajectory);
+
+#ifdef THREADS_STD
+    return std::make_pair(trajectory.profile, std::move(trajectory.steps));
+#else
+    return trajectory.profile;
+#endif
+  }
+
+  // calculate the whole motion ahead of time without moving the robot
+  Generator::Trajectory plan(const Spline& spline, const XFlags& flags = {},
+                             const PiecewiseTrapezoidal::Markers& markers = {});
+
+  // same as above, but keeps the concrete type of the spline so the spline can be inlined
+  template <class S>
+  Generator::Trajectory plan(const S& spline, const XFlags& flags = {},
+                             const PiecewiseTrapezoidal::Markers& markers = {}) {
+    std::vector<Generator::Step> steps;
+
+    // the robots heading
+    QAngle robot = flags.start.value_or(spline.calc(0).theta);
+
+    auto runner = [&](double t, Profile<>::State& k) {
+      steps.emplace_back(calc(spline.evaluate(t), k, robot, flags));
+    };
+
+    // use an SCurve between the markers if the limits have a jerk
+    Profile<>::Flags pflags {flags.start_v, flags.end_v, flags.top_v};
+    if (limits.j != Limits<>::Jerk {0.0}) {
+      auto profile = Generator::plan<SCurve<>>(limits, runner, spline, dt, pflags, markers);
+      return {std::move(profile), dt, std::move(steps)};
+    }
+    auto profile = Generator::plan(limits, runner, spline, dt, pflags, markers);
+    return {std::move(profile), dt, std::move(steps)};
+  }
+
+  // send a planned motion to the model, one step per timeslice
+  void execute(const Generator::Trajectory& trajectory);
+
+  // same as above, but for steps which are stored elsewhere, such as a TrajectoryFile. The robot is
+  // stopped first if the motion starts from rest.
+  void execute(std::span<const Generator::Step> steps, const QTime& idt,
+               const Number& start_v = 0_pct);
+
 protected:
+  // stop the robot if the motion starts from rest
+  void prepare(const Number& start_v);
+
+  // calculate the motion for one timeslice, given the sample of the spline and the heading of the
+  // robot, which is updated
+  Generator::Step calc(const Spline::Sample& sample, Profile<>::State& k, QAngle& robot,
+                       const XFlags& flags) {
+    auto profiled_vel = k.v; // used for logging
+    auto angler = flags.steerer(k);
+    auto w = flags.rotator(k) + angler;
+    w = std::clamp(w, -limits.w, limits.w);
+
+    // get the location and curvature on the spline
+    auto pos = sample.state;
+    auto curvature = sample.curvature;
+    pos.theta = pos.theta - robot + flags.strafer(k);
+
+    // this is experimental
+    auto scale = (sin(pos.theta).abs() + cos(pos.theta).abs());
+    if (flags.curve) {
+      k.v = std::min(k.v, (limits.w * limits.v / scale) /
+                            (curvature.abs() * limits.v / scale * radian + limits.w));
+    } else {
+      k.v = std::min(k.v, limits.v / scale - w.abs() * limits.v / limits.w);
+    }
+
+    // angular speed is curvature times limited speed
+    if (flags.curve) { w += curvature * k.v * radian; }
+
+    robot += (w - angler) * dt;
+
+    auto turning = -(w / radian * scales.wheelTrack) / 2;
+    auto left = k.v * cos(pos.theta + 45_deg);
+    auto right = k.v * cos(pos.theta - 45_deg);
+    k.v = k.v / scale;
+
+    auto topLeft = left + turning;
+    auto topRight = right - turning;
+    auto bottomLeft = right + turning;
+    auto bottomRight = left - turning;
+
+    auto topLeftSpeed = Generator::toWheel(topLeft, scales, gearset).convert(number);
+    auto topRightSpeed = Generator::toWheel(topRight, scales, gearset).convert(number);
+    auto bottomLeftSpeed = Generator::toWheel(bottomLeft, scales, gearset).convert(number);
+    auto bottomRightSpeed = Generator::toWheel(bottomRight, scales, gearset).convert(number);
+
+    return {pos, k, w, curvature, profiled_vel, topLeftSpeed, topRightSpeed, bottomLeftSpeed,
+            bottomRightSpeed};
+  }
+
   std::shared_ptr<XDriveModel> model;
   QAngularSpeed gearset;
   ChassisScales scales;
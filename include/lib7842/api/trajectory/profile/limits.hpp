@@ -11,19 +11,31 @@ using namespace okapi;
 template <class Unit = QLength> struct Limits {
   using Speed = decltype(Unit {1.0} / QTime {1.0});
   using Accel = decltype(Speed {1.0} / QTime {1.0});
+  using Jerk = decltype(Accel {1.0} / QTime {1.0});
 
   Accel a; // max acceleration
   Speed v; // max linear velocity
+  Jerk j {0.0}; // max jerk, or zero if the acceleration can change instantly
 
   Limits(const QAcceleration& ia, const Speed& iv) : a(ia), v(iv) {}
 
   Limits(const QTime& ia, const Speed& iv) : a(iv / ia), v(iv) {}
+
+  // the same limits, but the acceleration takes a time to ramp up to its max
+  Limits with_jerk(const QTime& ij) const {
+    Limits limits = *this;
+    limits.j = a / ij;
+    return limits;
+  }
 };
 
 template <> struct Limits<> {
+  using Jerk = decltype(QAcceleration {1.0} / QTime {1.0});
+
   QAcceleration a; // max acceleration
   QSpeed v; // max linear velocity
   QAngularSpeed w; // max angular velocity
+  Jerk j {0.0}; // max jerk, or zero if the acceleration can change instantly
 
   Limits(const QAcceleration& ia, const QSpeed& iv, const QAngularSpeed& iw) :
     a(ia), v(iv), w(iw) {}
@@ -45,6 +57,13 @@ template <> struct Limits<> {
   constexpr QSpeed max_vel_at_w(const QAngularSpeed& iw) const {
     return std::max(0_mps, v - (v * iw.abs()) / w);
   }
+
+  // the same limits, but the acceleration takes a time to ramp up to its max
+  Limits with_jerk(const QTime& ij) const {
+    Limits limits = *this;
+    limits.j = a / ij;
+    return limits;
+  }
 };
 
 } // namespace lib7842
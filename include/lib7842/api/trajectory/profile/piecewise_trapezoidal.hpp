@@ -1,17 +1,21 @@
 #pragma once
+#include "s_curve.hpp"
 #include "trapezoidal.hpp"
-#include <numeric>
+#include <algorithm>
 #include <queue>
+#include <utility>
 
 namespace lib7842 {
 
-class PiecewiseTrapezoidal : public Profile<> {
+// a profile made of a chain of profiles, which are split at the markers. P is the type of each
+// profile, such as a Trapezoidal or an SCurve, which is made from limits, a length, and flags.
+template <class P = Trapezoidal<>> class PiecewiseProfile : public Profile<> {
 public:
   // a list of distance and velocity percentages that mark the piecewise
   using Markers = std::vector<std::pair<Number, Number>>;
 
-  PiecewiseTrapezoidal(const Limits<>& ilimits, const QLength& ilength, const Flags& iflags = {},
-                       const Markers& imarkers = {}) {
+  PiecewiseProfile(const Limits<>& ilimits, const QLength& ilength, const Flags& iflags = {},
+                   const Markers& imarkers = {}) {
 
     auto allMarkers = std::deque<std::pair<Number, Number>>(imarkers.begin(), imarkers.end());
     allMarkers.emplace_front(0_pct, iflags.start_v);
@@ -26,40 +30,93 @@ public:
 
     std::transform(segments.begin(), segments.end(), std::back_inserter(profiles),
                    [&](const std::pair<QLength, Flags>& pair) {
-                     return Trapezoidal<>(ilimits, pair.first, pair.second);
+                     return P(ilimits, pair.first, pair.second);
                    });
 
-    time = std::accumulate(
-      profiles.begin(), profiles.end(), 0_s,
-      [](const QTime& totalT, const Trapezoidal<>& profile) { return totalT + profile.end().t; });
-  }
-
-  State calc(QTime t) const override {
-    QTime totalT = 0_s;
+    // the time and distance at the start of each profile
+    starts.reserve(profiles.size() + 1);
+    starts.emplace_back(0_s, 0_m);
     for (auto&& profile : profiles) {
-      if (t >= profile.begin().t + totalT && t <= profile.end().t + totalT) {
-        return profile.calc(t - totalT);
-      }
-      totalT += profile.end().t;
+      auto k = profile.end();
+      starts.emplace_back(starts.back().first + k.t, starts.back().second + k.d);
     }
-    return {};
+    time = starts.back().first;
   }
 
-  State calc(QLength d) const override {
-    QLength totalD = 0_m;
-    for (auto&& profile : profiles) {
-      if (d >= profile.begin().d + totalD && d <= profile.end().d + totalD) {
-        return profile.calc(d - totalD);
+  State calc(QTime t) const override { return calc(find(t), t); }
+  State calc(QLength d) const override { return calc(find(d), d); }
+
+  State begin() const override { return offset(0, profiles.front().begin()); }
+  State end() const override { return offset(profiles.size() - 1, profiles.back().end()); }
+
+  // A cursor remembers which profile the last query was in. Queries that only move forward, such as
+  // the distance travelled every timeslice, then only check the profile after the last one instead
+  // of searching, which takes amortized constant time no matter how many markers there are.
+  class Cursor {
+  public:
+    explicit Cursor(const PiecewiseProfile& iprofile) : profile(iprofile) {}
+
+    State calc(QTime t) { return profile.calc(advance(t), t); }
+    State calc(QLength d) { return profile.calc(advance(d), d); }
+
+  protected:
+    const PiecewiseProfile& profile;
+    size_t i {0}; // the profile of the last query
+
+    // move forward to the profile containing x, or search for it if x is behind the last query
+    template <class T> size_t advance(const T& x) {
+      if (x < start<T>(i)) {
+        i = profile.find(x);
+      } else {
+        while (i + 1 < profile.profiles.size() && x >= start<T>(i + 1)) {
+          ++i;
+        }
       }
-      totalD += profile.end().d;
+      return i;
     }
-    return {};
-  }
 
-  State begin() const override { return profiles.front().begin(); }
-  State end() const override { return profiles.back().end(); }
+    template <class T> T start(size_t j) const { return std::get<T>(profile.starts[j]); }
+  };
+
+  // make a cursor, which must not outlive the profile
+  Cursor cursor() const { return Cursor(*this); }
 
 protected:
-  std::vector<Trapezoidal<>> profiles {};
+  std::vector<P> profiles {};
+  std::vector<std::pair<QTime, QLength>> starts {}; // the time and distance before each profile
+
+  // find the profile containing a time or distance using a binary search of the starts
+  size_t find(const QTime& t) const {
+    auto it = std::upper_bound(starts.begin() + 1, starts.end() - 1, t,
+                               [](const QTime& x, const auto& start) { return x < start.first; });
+    return it - starts.begin() - 1;
+  }
+  size_t find(const QLength& d) const {
+    auto it = std::upper_bound(
+      starts.begin() + 1, starts.end() - 1, d,
+      [](const QLength& x, const auto& start) { return x < start.second; });
+    return it - starts.begin() - 1;
+  }
+
+  // sample a profile, given the time or distance from the start of the piecewise
+  State calc(size_t i, const QTime& t) const {
+    return offset(i, profiles[i].calc(t - starts[i].first));
+  }
+  State calc(size_t i, const QLength& d) const {
+    return offset(i, profiles[i].calc(d - starts[i].second));
+  }
+
+  // move the state of a profile to be relative to the start of the piecewise
+  State offset(size_t i, State k) const {
+    k.t += starts[i].first;
+    k.d += starts[i].second;
+    k.length = starts.back().second;
+    k.time = time;
+    return k;
+  }
 };
+
+using PiecewiseTrapezoidal = PiecewiseProfile<Trapezoidal<>>;
+using PiecewiseSCurve = PiecewiseProfile<SCurve<>>;
+
 } // namespace lib7842
@@ -0,0 +1,207 @@
+#pragma once
+#include "limits.hpp"
+#include "profile.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+
+namespace lib7842 {
+
+// An SCurve is a profile like Trapezoidal, except that the acceleration ramps up and down at a
+// limited jerk instead of switching instantly, which gives the velocity an S shape. Since the
+// wheels are never asked for a sudden change in force, they slip less at high acceleration limits.
+//
+// Each change of speed has three phases: the acceleration ramps up, holds at its max, and ramps
+// back down. If the change is too small to reach the max acceleration, the hold is skipped. With a
+// cruise in between, the profile is seven phases of constant jerk, so calc by time is a cubic
+// polynomial, and calc by distance solves that cubic in closed form. If the top speed can't be
+// reached within the length, the highest speed that can is found by bisection when the profile is
+// created.
+//
+// If the limits have no jerk, the ramps take no time, and the profile is the same as a Trapezoidal.
+template <class Unit = QLength> class SCurve : public Profile<Unit> {
+public:
+  using Speed = typename Profile<Unit>::Speed;
+  using Accel = typename Profile<Unit>::Accel;
+  using Jerk = decltype(Accel {1.0} / QTime {1.0});
+
+  constexpr SCurve(const Limits<Unit>& ilimits, const Unit& ilength,
+                   const typename Profile<Unit>::Flags& iflags = {}) :
+    limits(ilimits),
+    length(ilength),
+    start_v(limits.v * iflags.start_v),
+    end_v(limits.v * iflags.end_v) {
+    auto top = limits.v * iflags.top_v;
+
+    // the slowest profile only changes speed once
+    vel = std::max(start_v, end_v);
+    if (vel > top || distance(start_v, vel) + distance(vel, end_v) > length) {
+      throw std::runtime_error("Impossible deceleration constraints");
+    }
+
+    if (distance(start_v, top) + distance(top, end_v) <= length) {
+      vel = top;
+    } else {
+      // the distance needed grows with the top speed, so search for the speed that needs the length
+      Speed high = top;
+      for (size_t i = 0; i < 64; ++i) {
+        Speed mid = (vel + high) / 2;
+        (distance(start_v, mid) + distance(mid, end_v) <= length ? vel : high) = mid;
+      }
+    }
+
+    ramp(start_v, vel);
+    Unit cruise_d = length - distance(start_v, vel) - distance(vel, end_v);
+    add(vel > Speed {0.0} ? cruise_d / vel : 0_s, Accel {0.0}, Jerk {0.0});
+    ramp(vel, end_v);
+    Profile<Unit>::time = phases.back().t + phases.back().duration;
+  }
+
+  constexpr typename Profile<Unit>::State calc(QTime t) const override {
+    t = std::clamp(t, 0_s, Profile<Unit>::time);
+    for (auto&& phase : phases) {
+      if (t < phase.t + phase.duration) { return at(phase, t - phase.t); }
+    }
+    return end();
+  }
+
+  constexpr typename Profile<Unit>::State calc(Unit d) const override {
+    d = std::clamp(d, Unit {0.0}, length);
+    for (size_t i = 0; i < phases.size(); ++i) {
+      auto& phase = phases[i];
+      if (d < (i + 1 < phases.size() ? phases[i + 1].d : length)) {
+        double s = solve(phase.v.getValue(), phase.a.getValue(), phase.j.getValue(),
+                         (d - phase.d).getValue(), phase.duration.getValue());
+        auto k = at(phase, QTime {s});
+        k.d = d;
+        return k;
+      }
+    }
+    return end();
+  }
+
+  constexpr typename Profile<Unit>::State begin() const override { return at(phases.front(), 0_s); }
+
+  constexpr typename Profile<Unit>::State end() const override {
+    auto k = at(phases.back(), phases.back().duration);
+    k.d = length;
+    k.v = end_v;
+    return k;
+  }
+
+protected:
+  // a part of the profile with a constant jerk
+  struct Phase {
+    QTime t {0.0}; // the time at the start of the phase
+    Unit d {0.0}; // the distance at the start of the phase
+    Speed v {0.0}; // the velocity at the start of the phase
+    Accel a {0.0}; // the acceleration at the start of the phase
+    Jerk j {0.0}; // the jerk during the phase
+    QTime duration {0.0}; // the time spent in the phase
+  };
+
+  Limits<Unit> limits; // the kinematic limits
+  Unit length; // the length of the profile
+  Speed start_v; // the starting velocity
+  Speed end_v; // the ending velocity
+  Speed vel; // the top speed reached during the profile
+  std::array<Phase, 7> phases {};
+  size_t count {0}; // the number of phases which have been added
+
+  // the time spent ramping the acceleration, and the total time to change speed by dv
+  constexpr std::pair<QTime, QTime> times(const Speed& dv) const {
+    if (limits.j == Jerk {0.0}) { return {0_s, dv / limits.a}; }
+    if (dv >= square(limits.a) / limits.j) {
+      QTime ramp_t = limits.a / limits.j;
+      return {ramp_t, dv / limits.a + ramp_t};
+    }
+    QTime ramp_t = sqrt(dv / limits.j);
+    return {ramp_t, 2 * ramp_t};
+  }
+
+  // the distance it takes to change speed, which is symmetric so the average speed is the midpoint
+  constexpr Unit distance(const Speed& from, const Speed& to) const {
+    return (from + to) / 2 * times((to - from).abs()).second;
+  }
+
+  // add the three phases that change speed
+  constexpr void ramp(const Speed& from, const Speed& to) {
+    double sign = to >= from ? 1.0 : -1.0;
+    auto [ramp_t, total_t] = times((to - from).abs());
+    Accel peak = ramp_t > 0_s ? limits.j * ramp_t : limits.a;
+    add(ramp_t, Accel {0.0}, sign * limits.j);
+    add(total_t - 2 * ramp_t, sign * peak, Jerk {0.0});
+    add(ramp_t, sign * peak, -sign * limits.j);
+  }
+
+  // add a phase which starts where the last phase ended
+  constexpr void add(const QTime& duration, const Accel& a, const Jerk& j) {
+    Phase phase {0_s, Unit {0.0}, start_v, a, j, std::max(0_s, duration)};
+    if (count > 0) {
+      auto k = at(phases[count - 1], phases[count - 1].duration);
+      phase.t = k.t;
+      phase.d = k.d;
+      phase.v = k.v;
+    }
+    phases[count++] = phase;
+  }
+
+  // the state after some time within a phase
+  constexpr typename Profile<Unit>::State at(const Phase& p, const QTime& s) const {
+    typename Profile<Unit>::State k;
+    k.t = p.t + s;
+    k.d = p.d + p.v * s + p.a * square(s) / 2 + p.j * square(s) * s / 6;
+    k.a = p.a + p.j * s;
+    k.v = p.v + p.a * s + p.j * square(s) / 2;
+    k.length = length;
+    k.vel = vel;
+    k.time = Profile<Unit>::time;
+    return k;
+  }
+
+  // find the time within a phase at which a distance x is travelled, given the velocity v,
+  // acceleration a, and jerk j at its start, by solving v*s + a*s^2/2 + j*s^3/6 = x
+  static constexpr double solve(double v, double a, double j, double x, double max) {
+    double s {0.0};
+    if (j == 0.0) {
+      // a quadratic, written in a form that is stable when the acceleration is small
+      double den = v + std::sqrt(std::max(0.0, v * v + 2 * a * x));
+      s = den > 0.0 ? 2 * x / den : 0.0;
+    } else {
+      // a cubic, normalized to s^3 + b*s^2 + c*s + d and depressed by substituting s = y - b/3
+      double b = 3 * a / j;
+      double c = 6 * v / j;
+      double d = -6 * x / j;
+      double p = c - b * b / 3;
+      double q = 2 * b * b * b / 27 - b * c / 3 + d;
+      double disc = q * q / 4 + p * p * p / 27;
+      if (disc >= 0.0) {
+        double r = std::sqrt(disc);
+        s = std::cbrt(-q / 2 + r) + std::cbrt(-q / 2 - r) - b / 3;
+      } else {
+        // there are three real roots, so use the one within the phase
+        double m = 2 * std::sqrt(-p / 3);
+        double theta = std::acos(std::clamp(3 * q / (p * m), -1.0, 1.0)) / 3;
+        double error = std::numeric_limits<double>::infinity();
+        for (size_t k = 0; k < 3; ++k) {
+          double root = m * std::cos(theta - 2 * std::numbers::pi * k / 3) - b / 3;
+          double e = std::abs(root - std::clamp(root, 0.0, max));
+          if (e < error) {
+            error = e;
+            s = root;
+          }
+        }
+      }
+      // polish the root with a step of Newton's method, since the closed form loses precision
+      double f = v * s + a * s * s / 2 + j * s * s * s / 6 - x;
+      double df = v + a * s + j * s * s / 2;
+      if (df != 0.0) { s -= f / df; }
+    }
+    return std::clamp(s, 0.0, max);
+  }
+};
+
+} // namespace lib7842
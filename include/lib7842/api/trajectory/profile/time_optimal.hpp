@@ -0,0 +1,141 @@
+#pragma once
+#include "lib7842/api/positioning/spline/lengthTable.hpp"
+#include "limits.hpp"
+#include "piecewise_trapezoidal.hpp"
+#include "profile.hpp"
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace lib7842 {
+
+// A TimeOptimal profile is the fastest motion along a spline that stays within the limits at every
+// point. Where PiecewiseTrapezoidal only knows the length of the spline, so the curvature can only
+// clip the speed after the profile is fixed, this profile samples the spline at even distances and
+// caps the speed of each sample by its curvature: the outer wheel can't exceed the linear velocity
+// while turning, the angular velocity is limited, and so is the centripetal acceleration if given.
+// A forward pass then limits each sample to the speed it can accelerate to from the sample before
+// it, and a backward pass to the speed it can still brake from before the sample after it. The
+// result brakes in time for a tight turn, and accelerates as soon as the turn allows.
+//
+// The samples are a fixed distance apart, 1 cm by default, so a turn can't fall between two of
+// them however long the path is. The acceleration is constant between two samples, so calc is
+// exact within each interval.
+class TimeOptimal : public Profile<> {
+public:
+  // a list of distance and velocity percentages, the same as PiecewiseTrapezoidal. Here each
+  // marker caps the speed at its distance rather than splitting the profile.
+  using Markers = PiecewiseTrapezoidal::Markers;
+
+  template <class S>
+  TimeOptimal(const Limits<>& ilimits, const S& ispline, const Flags& iflags = {},
+              const Markers& imarkers = {},
+              const std::optional<QAcceleration>& icentripetal = std::nullopt,
+              const QLength& ispacing = 1_cm) :
+    lengths(ispline) {
+    if (ispacing <= 0_m) {
+      throw std::invalid_argument("TimeOptimal: spacing must be greater than zero");
+    }
+    for (auto&& [d, v] : imarkers) {
+      if (d < 0_pct || d > 100_pct) {
+        throw std::invalid_argument("TimeOptimal: markers must be between 0% and 100%");
+      }
+    }
+    // sample the spline at even distances, so a long path is sampled as finely as a short one
+    length = lengths.length();
+    size_t resolution = std::max<size_t>(1, std::ceil((length / ispacing).convert(number) - 1e-9));
+    ds = length / resolution;
+    std::vector<double> ts(resolution + 1);
+    for (size_t i = 0; i < ts.size(); ++i) {
+      ts[i] = lengths.t_at_length(ds * i);
+    }
+    std::vector<QCurvature> curvatures(ts.size());
+    ispline.curvature_batch(ts, curvatures);
+
+    // the highest speed allowed by the curvature at each sample
+    QSpeed top = ilimits.v * iflags.top_v;
+    vels.resize(ts.size());
+    for (size_t i = 0; i < vels.size(); ++i) {
+      vels[i] = std::min(top, ilimits.max_vel_at_curvature(curvatures[i]));
+      if (icentripetal && curvatures[i] != QCurvature {0.0}) {
+        vels[i] = std::min(vels[i], sqrt(*icentripetal / curvatures[i].abs()));
+      }
+    }
+    for (auto&& [d, v] : imarkers) {
+      auto i = static_cast<size_t>(std::round(d.convert(number) * resolution));
+      vels[i] = std::min(vels[i], ilimits.v * v);
+    }
+    vels.front() = std::min(vels.front(), ilimits.v * iflags.start_v);
+    vels.back() = std::min(vels.back(), ilimits.v * iflags.end_v);
+
+    // limit each sample by how fast it can be reached, and how fast it can be left
+    for (size_t i = 1; i < vels.size(); ++i) {
+      vels[i] = std::min(vels[i], sqrt(square(vels[i - 1]) + 2 * ilimits.a * ds));
+    }
+    for (size_t i = vels.size() - 1; i > 0; --i) {
+      vels[i - 1] = std::min(vels[i - 1], sqrt(square(vels[i]) + 2 * ilimits.a * ds));
+    }
+
+    // the time at each sample
+    times.reserve(vels.size());
+    times.emplace_back(0_s);
+    for (size_t i = 1; i < vels.size(); ++i) {
+      QSpeed sum = vels[i - 1] + vels[i];
+      times.emplace_back(times.back() + (sum > 0_mps ? 2 * ds / sum : 0_s));
+    }
+    time = times.back();
+    vel = *std::max_element(vels.begin(), vels.end());
+  }
+
+  State calc(QTime t) const override {
+    t = std::clamp(t, 0_s, time);
+    size_t i = std::upper_bound(times.begin(), times.end(), t) - times.begin();
+    i = std::clamp<size_t>(i, 1, vels.size() - 1) - 1;
+    QTime dt = t - times[i];
+    QAcceleration a = acceleration(i);
+    return state(t, ds * i + vels[i] * dt + 0.5 * a * square(dt), a, vels[i] + a * dt);
+  }
+
+  State calc(QLength d) const override {
+    d = std::clamp(d, 0_m, length);
+    size_t i = std::min(static_cast<size_t>((d / ds).convert(number)), vels.size() - 2);
+    QLength x = d - ds * i;
+    QAcceleration a = acceleration(i);
+    auto v_2 = square(vels[i]) + 2 * a * x;
+    QSpeed v = v_2 > decltype(v_2) {0.0} ? sqrt(v_2) : 0_mps;
+    QSpeed sum = vels[i] + v;
+    return state(times[i] + (sum > 0_mps ? 2 * x / sum : 0_s), d, a, v);
+  }
+
+  State begin() const override { return state(0_s, 0_m, acceleration(0), vels.front()); }
+  State end() const override {
+    return state(time, length, acceleration(vels.size() - 2), vels.back());
+  }
+
+  // the speed at each sample, which are spaced evenly along the spline
+  const std::vector<QSpeed>& velocities() const { return vels; }
+
+  // the length table of the spline, so that following the profile doesn't need to build another
+  const LengthTable& table() const { return lengths; }
+
+protected:
+  LengthTable lengths; // maps distance along the spline to t
+  QLength length; // the length of the spline
+  QLength ds; // the distance between samples
+  QSpeed vel; // the top speed reached during the profile
+  std::vector<QSpeed> vels {}; // the speed at each sample
+  std::vector<QTime> times {}; // the time at each sample
+
+  // the constant acceleration between a sample and the next
+  QAcceleration acceleration(size_t i) const {
+    return (square(vels[i + 1]) - square(vels[i])) / (2 * ds);
+  }
+
+  State state(const QTime& t, const QLength& d, const QAcceleration& a, const QSpeed& v) const {
+    return {t, d, a, v, length, vel, time};
+  }
+};
+
+} // namespace lib7842
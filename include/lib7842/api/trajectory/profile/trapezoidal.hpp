@@ -68,7 +68,7 @@ public:
       k.a = limits.a * -1;
       QTime t_from_decel = (t - accel_t - cruise_t);
       k.v = vel - t_from_decel * limits.a;
-      k.d = accel_d + cruise_d + end_v * t_from_decel + 0.5 * limits.a * square(t_from_decel);
+      k.d = accel_d + cruise_d + vel * t_from_decel - 0.5 * limits.a * square(t_from_decel);
     }
     k.t = t;
     k.length = length;
@@ -3,8 +3,42 @@
 #include <iostream>
 namespace test {
 
+// reference implementation which sums the bernstein basis of each control point
+template <size_t N> double bernstein(const std::array<double, N>& ctrls, double x) {
+  double sum {0.0};
+  for (size_t i = 0; i < N; ++i) {
+    double c {1.0};
+    for (size_t k = 1; k <= i; ++k) {
+      c = c * (N - 1 - i + k) / k;
+    }
+    sum += c * std::pow(1.0 - x, N - 1 - i) * std::pow(x, i) * ctrls[i];
+  }
+  return sum;
+}
+
 TEST_CASE("Bezier") {
   std::array a {0.0, 1.0, 2.0, 3.0};
   BezierFnc b(a);
+
+  SUBCASE("Linear") {
+    for (size_t i = 0; i <= 10; ++i) {
+      CHECK(b.calc(i / 10.0) == Approx(i / 10.0 * 3.0));
+      CHECK(b.calc_d(i / 10.0) == Approx(3.0));
+      CHECK(b.calc_d2(i / 10.0) == Approx(0.0));
+    }
+  }
+
+  SUBCASE("Bernstein") {
+    std::array c {0.0, 2.0, -1.0, 4.0, 0.5, 1.0};
+    BezierFnc q(c);
+    std::array d {2.0 * 5, -3.0 * 5, 5.0 * 5, -3.5 * 5, 0.5 * 5};
+    std::array d2 {-5.0 * 20, 8.0 * 20, -8.5 * 20, 4.0 * 20};
+    for (size_t i = 0; i <= 10; ++i) {
+      CHECK(q.calc(i / 10.0) == Approx(bernstein(c, i / 10.0)));
+      CHECK(q.calc_d(i / 10.0) == Approx(bernstein(d, i / 10.0)));
+      CHECK(q.calc_d2(i / 10.0) == Approx(bernstein(d2, i / 10.0)));
+    }
+  }
+
 }
 } // namespace test
@@ -0,0 +1,64 @@
+#include "lib7842/api/positioning/spline/bezierTree.hpp"
+#include "lib7842/test/test.hpp"
+namespace test {
+TEST_CASE("BezierTree") {
+  CubicBezier b({{0_m, 0_m}, {0_m, 1_m}, {1_m, 1_m}, {1_m, 0_m}});
+
+  SUBCASE("Split") {
+    auto [left, right] = b.split(0.3);
+    for (size_t i = 0; i <= 10; ++i) {
+      double t = i / 10.0;
+      CHECK(left.calc(t).distTo(b.calc(t * 0.3)).convert(meter) == Approx(0.0));
+      CHECK(right.calc(t).distTo(b.calc(0.3 + t * 0.7)).convert(meter) == Approx(0.0));
+    }
+    CHECK(left.controls()[0] == b.controls()[0]);
+    CHECK(right.controls()[3] == b.controls()[3]);
+  }
+
+  SUBCASE("Distance") {
+    BezierTree tree(b, 0.1_mm);
+    for (const Vector& point : {Vector {0.5_m, 2_m}, Vector {0.5_m, 0_m}, Vector {-1_m, -1_m}}) {
+      QLength closest = 1_km;
+      for (auto&& ip : b.step(StepBy::Count(10000))) {
+        closest = std::min(closest, ip.distTo(point));
+      }
+      CHECK(tree.distance(point).convert(meter) == Approx(closest.convert(meter)).epsilon(1e-3));
+    }
+  }
+
+  SUBCASE("Obstacles") {
+    BezierTree tree(b);
+    // the curve peaks at 0.75m
+    CHECK(tree.intersects({{0.4_m, 0.7_m}, {0.6_m, 0.8_m}}));
+    CHECK_FALSE(tree.intersects({{0.4_m, 0.8_m}, {0.6_m, 0.9_m}}));
+    CHECK_FALSE(tree.intersects({{0.3_m, 0.1_m}, {0.7_m, 0.5_m}}));
+    CHECK(tree.intersects({0.5_m, 0.3_m}, 0.5_m));
+    CHECK_FALSE(tree.intersects({0.5_m, 0.3_m}, 0.4_m));
+    auto box = tree.bounds();
+    CHECK(box.min == Vector {0_m, 0_m});
+    CHECK(box.max == Vector {1_m, 1_m});
+  }
+
+  SUBCASE("Paths") {
+    BezierTree tree(b);
+    CHECK(tree.intersects(BezierTree(CubicBezier({{0_m, 0.5_m}, {0.3_m, 0.5_m}, {0.6_m, 0.5_m},
+                                                  {2_m, 0.5_m}}))));
+    CHECK_FALSE(tree.intersects(BezierTree(
+      CubicBezier({{0.2_m, 0_m}, {0.2_m, 0.5_m}, {0.8_m, 0.5_m}, {0.8_m, 0_m}}))));
+    CHECK(tree.intersects(BezierTree(QuinticBezier(
+      {{0.5_m, -1_m}, {0.5_m, 0_m}, {0.5_m, 1_m}, {0.5_m, 2_m}, {0.5_m, 3_m}, {0.5_m, 4_m}}))));
+  }
+
+  SUBCASE("Piecewise") {
+    auto p = make_piecewise<CubicBezier>({{{0_m, 0_m}, {0_m, 1_m}, {1_m, 1_m}, {1_m, 0_m}},
+                                          {{1_m, 0_m}, {1_m, -1_m}, {2_m, -1_m}, {2_m, 0_m}}});
+    BezierTree tree(p);
+    CHECK(tree.intersects({{1.4_m, -0.8_m}, {1.6_m, -0.7_m}}));
+    CHECK(tree.distance({1.5_m, -2_m}).convert(meter) == Approx(1.25).epsilon(1e-3));
+
+    auto d = make_piecewise(std::vector {b, CubicBezier({{1_m, 0_m}, {1_m, -1_m}, {2_m, -1_m},
+                                                         {2_m, 0_m}})});
+    CHECK(BezierTree(d).distance({1.5_m, -2_m}).convert(meter) == Approx(1.25).epsilon(1e-3));
+  }
+}
+} // namespace test
@@ -0,0 +1,74 @@
+#include "lib7842/api/positioning/spline/bspline.hpp"
+#include "lib7842/test/test.hpp"
+namespace test {
+TEST_CASE("BSpline") {
+  std::vector<Vector> ctrls {{0_m, 0_m}, {1_m, 2_m}, {2_m, -1_m}, {4_m, 0_m},
+                             {5_m, 3_m}, {3_m, 4_m}, {1_m, 5_m}, {0_m, 3_m}};
+
+  SUBCASE("Line") {
+    std::vector<Vector> line;
+    for (size_t i = 0; i < 10; ++i) {
+      line.emplace_back(i * 1_m, 0_m);
+    }
+    for (double t : {0.0, 0.1, 0.55, 1.0}) {
+      CHECK(CubicBSpline(line).calc(t).x.convert(meter) == Approx(1 + t * 7));
+      CHECK(QuinticBSpline(line).calc(t).x.convert(meter) == Approx(2 + t * 5));
+      CHECK(CubicBSpline(line).velocity(t).convert(meter) == Approx(7.0));
+    }
+  }
+
+  SUBCASE("Knots") {
+    CubicBSpline b(ctrls);
+    State start = b.calc(0);
+    CHECK(start.x.convert(meter) == Approx((0 + 4 * 1 + 2) / 6.0));
+    CHECK(start.y.convert(meter) == Approx((0 + 4 * 2 - 1) / 6.0));
+
+    QuinticBSpline q(ctrls);
+    CHECK(q.calc(0).x.convert(meter) == Approx((0 + 26 * 1 + 66 * 2 + 26 * 4 + 5) / 120.0));
+
+    // the derivatives are continuous across the knots
+    for (const Spline* s : {static_cast<const Spline*>(&b), static_cast<const Spline*>(&q)}) {
+      double spans = s == &b ? 5 : 3;
+      for (size_t i = 1; i < spans; ++i) {
+        double t = i / spans;
+        for (auto f : {&Spline::calc_d, &Spline::calc_d2}) {
+          Vector before = (s->*f)(t - 1e-9);
+          Vector after = (s->*f)(t);
+          CHECK(before.x.convert(meter) == Approx(after.x.convert(meter)).epsilon(1e-5));
+          CHECK(before.y.convert(meter) == Approx(after.y.convert(meter)).epsilon(1e-5));
+        }
+      }
+    }
+  }
+
+  SUBCASE("Derivatives") {
+    CubicBSpline b(ctrls);
+    for (double t : {0.1, 0.5, 0.9}) {
+      CHECK(b.calc_d(t).x.convert(meter) == Approx(b.Spline::calc_d(t).x.convert(meter)));
+      CHECK(b.calc_d2(t).y.convert(meter) ==
+            Approx(b.Spline::calc_d2(t).y.convert(meter)).epsilon(1e-3));
+      auto sample = b.evaluate(t);
+      CHECK(sample.velocity.convert(meter) == Approx(b.velocity(t).convert(meter)));
+      CHECK(sample.curvature.convert(1 / meter) == Approx(b.curvature(t).convert(1 / meter)));
+    }
+  }
+
+  SUBCASE("Set") {
+    CubicBSpline b(ctrls);
+    QLength length = b.cached_arc_length();
+    State far = b.calc(0.9);
+    b.set(0, {-1_m, -1_m});
+    ctrls[0] = {-1_m, -1_m};
+    CubicBSpline fresh(ctrls);
+    CHECK(b.calc(0.1).distTo(fresh.calc(0.1)).convert(meter) == Approx(0.0));
+    CHECK(b.calc(0.9) == far);
+    CHECK(b.cached_arc_length() != length);
+    CHECK(b.cached_arc_length().convert(meter) == Approx(fresh.arc_length().convert(meter)));
+    CHECK_THROWS(b.set(8, {0_m, 0_m}));
+  }
+
+  SUBCASE("Invalid") {
+    CHECK_THROWS_AS(QuinticBSpline({{0_m, 0_m}, {1_m, 1_m}}), std::invalid_argument);
+  }
+}
+} // namespace test
@@ -0,0 +1,60 @@
+#include "lib7842/api/positioning/spline/clothoid.hpp"
+#include "lib7842/api/positioning/spline/arc.hpp"
+#include "lib7842/test/test.hpp"
+namespace test {
+TEST_CASE("Clothoid") {
+  SUBCASE("Line") {
+    Clothoid c({1_m, 1_m, 45_deg}, 0 / meter, 0 / meter, 2_m);
+    State end = c.calc(1);
+    CHECK(end.x.convert(meter) == Approx(1 + std::sqrt(2.0)));
+    CHECK(end.y.convert(meter) == Approx(1 + std::sqrt(2.0)));
+    CHECK(c.curvature(0.5).convert(1 / meter) == 0.0);
+  }
+
+  SUBCASE("Arc") {
+    Clothoid c({0_m, 0_m, 0_deg}, 1 / meter, 1 / meter, M_PI / 2 * meter);
+    Arc arc({0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg});
+    for (double t : {0.0, 0.3, 0.5, 1.0}) {
+      CHECK(c.calc(t).distTo(arc.calc(t)).convert(meter) == Approx(0.0));
+      CHECK(c.calc(t).theta.convert(radian) == Approx(arc.calc(t).theta.convert(radian)));
+    }
+    CHECK(c.length().convert(meter) == Approx(arc.length().convert(meter)));
+  }
+
+  SUBCASE("Spiral") {
+    // a spiral that turns through more than a full circle
+    Clothoid c({0_m, 0_m, 0_deg}, 0 / meter, 8 / meter, 2_m);
+    CHECK(c.curvature(0.25).convert(1 / meter) == Approx(2.0));
+    CHECK(c.calc(1).theta.convert(radian) == Approx(8.0));
+    CHECK(c.length() == 2_m);
+
+    // compare against a much finer integration of the heading
+    for (double t : {0.1, 0.37, 0.5, 0.93, 1.0}) {
+      double dist = 2.0 * t;
+      auto theta = [](double s) { return 2 * s * s; };
+      double x = util::integrate([&](double s) { return std::cos(theta(s)); }, 0, dist, 1e-12);
+      double y = util::integrate([&](double s) { return std::sin(theta(s)); }, 0, dist, 1e-12);
+      State p = c.calc(t);
+      CHECK(std::abs(p.x.convert(meter) - x) < 1e-6);
+      CHECK(std::abs(p.y.convert(meter) - y) < 1e-6);
+    }
+
+    // the exact derivatives agree with the default finite differences
+    for (double t : {0.2, 0.6}) {
+      Vector d = c.calc_d(t);
+      Vector fd = c.Spline::calc_d(t);
+      CHECK(d.x.convert(meter) == Approx(fd.x.convert(meter)).epsilon(1e-4));
+      CHECK(d.y.convert(meter) == Approx(fd.y.convert(meter)).epsilon(1e-4));
+      Vector d2 = c.calc_d2(t);
+      Vector fd2 = c.Spline::calc_d2(t);
+      CHECK(d2.x.convert(meter) == Approx(fd2.x.convert(meter)).epsilon(1e-2));
+      CHECK(d2.y.convert(meter) == Approx(fd2.y.convert(meter)).epsilon(1e-2));
+    }
+  }
+
+  SUBCASE("Invalid") {
+    CHECK_THROWS_AS(Clothoid({0_m, 0_m, 0_deg}, 0 / meter, 1 / meter, 0_m),
+                    std::invalid_argument);
+  }
+}
+} // namespace test
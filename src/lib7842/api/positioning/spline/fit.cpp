@@ -0,0 +1,51 @@
+#include "lib7842/api/positioning/spline/fit.hpp"
+#include "lib7842/api/positioning/spline/bezierTree.hpp"
+#include "lib7842/test/test.hpp"
+namespace test {
+TEST_CASE("Fit") {
+  // a route with a few turns, sampled densely with some noise like odometry would be
+  auto route = make_piecewise<QuinticHermite>(
+    {{0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg}, {0_m, 2_m, 180_deg}, {-1_m, 3_m, 90_deg}});
+  std::vector<State> trace;
+  for (size_t i = 0; i <= 3000; ++i) {
+    double noise = (i % 7 == 0 ? 1.0 : -0.5) * 0.001;
+    State s = route.calc(i / 3000.0);
+    trace.emplace_back(s.x + noise * meter, s.y - noise * meter, s.theta);
+  }
+
+  SUBCASE("Bezier") {
+    auto p = fit<CubicBezier>(trace, 1_cm);
+    CHECK(p.size() < 20);
+    BezierTree tree(p, 0.1_mm);
+    for (const auto& ip : trace) {
+      REQUIRE(tree.distance(ip) < 1.01_cm);
+    }
+    CHECK(p.calc(0).distTo(trace.front()).convert(meter) == Approx(0.0));
+    CHECK(p.calc(1).distTo(trace.back()).convert(meter) == Approx(0.0));
+  }
+
+  SUBCASE("Hermite") {
+    auto p = fit<QuinticHermite>(trace, 1_cm);
+    CHECK(p.size() < 20);
+    for (size_t i = 0; i < trace.size(); i += 10) {
+      REQUIRE(p.project(trace[i]).error.abs() < 1.01_cm);
+    }
+  }
+
+  SUBCASE("Line") {
+    std::vector<State> line;
+    for (size_t i = 0; i <= 100; ++i) {
+      line.emplace_back(0_m, i * 1_cm, 90_deg);
+      line.emplace_back(0_m, i * 1_cm, 90_deg); // the robot stopped
+    }
+    auto p = fit<CubicBezier>(line, 1_mm);
+    CHECK(p.size() == 1);
+    CHECK(p.arc_length().convert(meter) == Approx(1.0));
+  }
+
+  SUBCASE("Invalid") {
+    std::vector<State> still(10, State {1_m, 1_m, 0_deg});
+    CHECK_THROWS_AS(fit<CubicBezier>(still, 1_cm), std::invalid_argument);
+  }
+}
+} // namespace test
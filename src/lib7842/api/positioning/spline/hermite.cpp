@@ -5,5 +5,21 @@ TEST_CASE("Hermite") {
   HermiteFnc<3>(0, 1, 0, 0);
   auto l = make_piecewise<CubicHermite>(
     {{{0_m, 0_m, 0_deg}, {1_m, 1_m, 0_deg}}, {{1_m, 1_m, 0_deg}, {2_m, 2_m, 0_deg}}});
+
+  SUBCASE("Endpoints") {
+    HermiteFnc<3> c(1, 2, 3, 4);
+    CHECK(c.calc(0) == Approx(1));
+    CHECK(c.calc_d(0) == Approx(2));
+    CHECK(c.calc(1) == Approx(3));
+    CHECK(c.calc_d(1) == Approx(4));
+
+    HermiteFnc<5> q(1, 2, 3, 4);
+    CHECK(q.calc(0) == Approx(1));
+    CHECK(q.calc_d(0) == Approx(2));
+    CHECK(q.calc_d2(0) == Approx(0));
+    CHECK(q.calc(1) == Approx(3));
+    CHECK(q.calc_d(1) == Approx(4));
+    CHECK(q.calc_d2(1) == Approx(0));
+  }
 }
 } // namespace test
@@ -0,0 +1,47 @@
+#include "lib7842/api/positioning/spline/lengthTable.hpp"
+#include "lib7842/api/positioning/spline/arc.hpp"
+#include "lib7842/api/positioning/spline/bezier.hpp"
+#include "lib7842/api/positioning/spline/line.hpp"
+#include "lib7842/test/test.hpp"
+namespace test {
+TEST_CASE("LengthTable") {
+  SUBCASE("Line") {
+    auto table = Line({0_m, 0_m}, {0_m, 2_m}).table();
+    CHECK(table.length().convert(meter) == Approx(2.0));
+    CHECK(table.t_at_length(0.5_m) == Approx(0.25));
+    CHECK(table.length_at_t(0.75).convert(meter) == Approx(1.5));
+  }
+
+  SUBCASE("Arc") {
+    Arc arc({0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg});
+    auto table = arc.table();
+    CHECK(table.length().convert(meter) == Approx(arc.length().convert(meter)));
+    CHECK(table.t_at_length(arc.length() / 2) == Approx(0.5));
+  }
+
+  SUBCASE("Bounds") {
+    auto table = Line({0_m, 0_m}, {0_m, 1_m}).table();
+    CHECK(table.t_at_length(-1_m) == 0.0);
+    CHECK(table.t_at_length(2_m) == 1.0);
+    CHECK(table.length_at_t(1.0) == table.length());
+  }
+
+  SUBCASE("RoundTrip") {
+    CubicBezier b({{0_m, 0_m}, {0_m, 3_m}, {0.2_m, 0.2_m}, {2_m, 2_m}});
+    auto table = b.table(200);
+    for (size_t i = 0; i <= 20; ++i) {
+      QLength d = table.length() * (i / 20.0);
+      CHECK(table.length_at_t(table.t_at_length(d)).convert(meter) ==
+            Approx(d.convert(meter)));
+    }
+  }
+
+  SUBCASE("Dist") {
+    CubicBezier b({{0_m, 0_m}, {0_m, 3_m}, {0.2_m, 0.2_m}, {2_m, 2_m}});
+    auto v = b.generate(StepBy::Dist(0.05_m));
+    for (size_t i = 1; i < v.size(); ++i) {
+      CHECK(v[i].distTo(v[i - 1]).convert(meter) == Approx(0.05).epsilon(0.05));
+    }
+  }
+}
+} // namespace test
@@ -0,0 +1,41 @@
+#include "lib7842/api/positioning/spline/mesh.hpp"
+#include "lib7842/test/test.hpp"
+namespace test {
+TEST_CASE("Mesh") {
+  auto check = [](const Vector& a, const Vector& b, double epsilon) {
+    CHECK(a.x.convert(meter) == Approx(b.x.convert(meter)).epsilon(epsilon));
+    CHECK(a.y.convert(meter) == Approx(b.y.convert(meter)).epsilon(epsilon));
+  };
+
+  SUBCASE("Arc") {
+    for (const Arc& arc : {Arc({0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg}),
+                           Arc({1_m, 0_m, 30_deg}, {0_m, 2_m, 30_deg})}) {
+      for (double t : {0.0, 0.4, 1.0}) {
+        auto [p, d, d2] = arc.calc_all(t);
+        check(p, arc.calc(t), 1e-9);
+        CHECK(p.theta.convert(radian) == Approx(arc.calc(t).theta.convert(radian)));
+        check(d, arc.calc_d(t), 1e-9);
+        check(d2, arc.calc_d2(t), 1e-9);
+        check(d, arc.Spline::calc_d(t), 1e-3);
+        check(d2, arc.Spline::calc_d2(t), 1e-2);
+      }
+    }
+  }
+
+  SUBCASE("Evaluate") {
+    for (const Mesh& mesh : {Mesh({0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg}),
+                             Mesh({0_m, 0_m, 90_deg}, {1_m, 2_m, 45_deg}),
+                             Mesh({0_m, 0_m, 45_deg}, {1_m, 1_m, 45_deg})}) {
+      for (double t : {0.1, 0.5, 0.9}) {
+        check(mesh.calc_d(t), mesh.Spline::calc_d(t), 1e-3);
+        check(mesh.calc_d2(t), mesh.Spline::calc_d2(t), 1e-2);
+        auto sample = mesh.evaluate(t);
+        check(sample.state, mesh.calc(t), 1e-9);
+        CHECK(sample.velocity.convert(meter) == Approx(mesh.velocity(t).convert(meter)));
+        CHECK(sample.curvature.convert(1 / meter) ==
+              Approx(mesh.curvature(t).convert(1 / meter)));
+      }
+    }
+  }
+}
+} // namespace test
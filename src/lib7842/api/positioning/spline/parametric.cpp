@@ -1,10 +1,212 @@
+#include "lib7842/api/positioning/spline/arc.hpp"
 #include "lib7842/api/positioning/spline/bezier.hpp"
 #include "lib7842/api/positioning/spline/hermite.hpp"
+#include "lib7842/api/positioning/spline/line.hpp"
 #include "lib7842/test/test.hpp"
 namespace test {
 
+// a cubic written once over its number type, to compare against the hand-written derivatives
+struct Cubic {
+  std::array<double, 4> c;
+  template <class T> constexpr T calc(T x) const {
+    return ((c[3] * x + c[2]) * x + c[1]) * x + c[0];
+  }
+};
+
+struct Wave {
+  double a;
+  template <class T> T calc(T x) const {
+    using std::exp;
+    using std::sin;
+    return a * sin(x * 3.0) * exp(-x) / (x + 1.0);
+  }
+};
+
 TEST_CASE("Parametric") {
   CubicHermite c({0_in, 0_in, 0_deg}, {1_in, 1_in, 0_deg});
   CubicBezier s({{0_m, 0_m}, {1_m, 1_m}, {2_m, 2_m}, {3_m, 3_m}});
+
+  SUBCASE("ArcLength") {
+    CHECK(s.arc_length().convert(meter) == Approx(std::sqrt(18.0)));
+    CubicHermite h({0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg}, 1.5);
+    CHECK(h.arc_length(1e-6_m).convert(meter) == Approx(h.length(5000).convert(meter)));
+  }
+
+  SUBCASE("Evaluate") {
+    CubicHermite h({0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg}, 1.5);
+    for (double t : {0.0, 0.3, 0.7, 1.0}) {
+      auto sample = h.evaluate(t);
+      State state = h.calc(t);
+      CHECK(sample.state.x.convert(meter) == Approx(state.x.convert(meter)));
+      CHECK(sample.state.y.convert(meter) == Approx(state.y.convert(meter)));
+      CHECK(sample.state.theta.convert(radian) == Approx(state.theta.convert(radian)));
+      CHECK(sample.velocity.convert(meter) == Approx(h.velocity(t).convert(meter)));
+      CHECK(sample.curvature.convert(1 / meter) == Approx(h.curvature(t).convert(1 / meter)));
+    }
+  }
+
+  SUBCASE("Batch") {
+    CubicHermite h({0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg}, 1.5);
+    std::vector<double> ts(150);
+    for (size_t i = 0; i < ts.size(); ++i) {
+      ts[i] = i / 149.0;
+    }
+    std::vector<State> states(ts.size());
+    std::vector<QCurvature> curvatures(ts.size());
+    std::vector<QLength> velocities(ts.size());
+    h.calc_batch(ts, states);
+    h.curvature_batch(ts, curvatures);
+    h.velocity_batch(ts, velocities);
+    for (size_t i = 0; i < ts.size(); ++i) {
+      State state = h.calc(ts[i]);
+      CHECK(states[i].x.convert(meter) == Approx(state.x.convert(meter)));
+      CHECK(states[i].y.convert(meter) == Approx(state.y.convert(meter)));
+      CHECK(states[i].theta.convert(radian) == Approx(state.theta.convert(radian)));
+      CHECK(curvatures[i].convert(1 / meter) == Approx(h.curvature(ts[i]).convert(1 / meter)));
+      CHECK(velocities[i].convert(meter) == Approx(h.velocity(ts[i]).convert(meter)));
+    }
+    CHECK_THROWS(h.calc_batch(ts, std::span(states).first(10)));
+  }
+
+  SUBCASE("Project") {
+    CubicHermite h({0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg}, 1.5);
+    for (Vector point : {Vector(0.2_m, 0.6_m), Vector(1.2_m, 0.1_m), Vector(-0.5_m, 0.5_m)}) {
+      // compare against a brute force search
+      double best = 0;
+      for (size_t i = 0; i <= 10000; ++i) {
+        if (h.calc(i / 10000.0).distTo(point) < h.calc(best).distTo(point)) { best = i / 10000.0; }
+      }
+      auto projection = h.project(point);
+      CHECK(projection.t == Approx(best).epsilon(1e-3));
+      CHECK(projection.error.abs().convert(meter) ==
+            Approx(h.calc(best).distTo(point).convert(meter)));
+
+      // a hint close to the answer converges to the same point
+      auto warm = h.project(point, best + 0.02);
+      CHECK(warm.t == Approx(projection.t));
+    }
+
+    // the error is positive to the left of the spline
+    auto line = Line({0_m, 0_m}, {0_m, 2_m});
+    auto left = line.project({-1_m, 1_m});
+    CHECK(left.t == Approx(0.5));
+    CHECK(left.error.convert(meter) == Approx(1.0));
+    CHECK(line.project({1_m, 1_m}).error.convert(meter) == Approx(-1.0));
+    CHECK(line.project({1_m, 3_m}).t == 1.0);
+  }
+
+  SUBCASE("Derivatives") {
+    // the exact derivatives agree with the default finite differences
+    CubicHermite h({0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg}, 1.5);
+    for (double t : {0.0, 0.3, 0.7, 1.0}) {
+      Vector d = h.calc_d(t);
+      Vector d2 = h.calc_d2(t);
+      Vector fd = h.Spline::calc_d(t);
+      Vector fd2 = h.Spline::calc_d2(t);
+      CHECK(d.x.convert(meter) == Approx(fd.x.convert(meter)).epsilon(1e-3));
+      CHECK(d.y.convert(meter) == Approx(fd.y.convert(meter)).epsilon(1e-3));
+      CHECK(d2.x.convert(meter) == Approx(fd2.x.convert(meter)).epsilon(1e-2));
+      CHECK(d2.y.convert(meter) == Approx(fd2.y.convert(meter)).epsilon(1e-2));
+    }
+  }
+
+  SUBCASE("Auto") {
+    PolynomialFnc<3> poly({1.0, -2.0, 3.0, 0.5});
+    AutoFnc fnc(Cubic {{1.0, -2.0, 3.0, 0.5}});
+    for (double x : {0.0, 0.25, 0.5, 1.0}) {
+      auto [y, d, d2] = fnc.evaluate(x);
+      CHECK(y == Approx(poly.calc(x)));
+      CHECK(d == Approx(poly.calc_d(x)));
+      CHECK(d2 == Approx(poly.calc_d2(x)));
+      CHECK(fnc.calc_d(x) == Approx(poly.calc_d(x)));
+      CHECK(fnc.calc_d2(x) == Approx(poly.calc_d2(x)));
+    }
+
+    // the quotient, product, and chain rules against finite differences
+    AutoFnc wave(Wave {2.0});
+    for (double x : {0.1, 0.4, 0.9}) {
+      double h = 1e-4;
+      double fd = (wave.calc(x + h) - wave.calc(x - h)) / (2 * h);
+      double fd2 = (wave.calc(x + h) - 2 * wave.calc(x) + wave.calc(x - h)) / (h * h);
+      CHECK(wave.calc_d(x) == Approx(fd).epsilon(1e-6));
+      CHECK(wave.calc_d2(x) == Approx(fd2).epsilon(1e-4));
+    }
+
+    Parametric<AutoFnc<Cubic>> p(AutoFnc(Cubic {{0.0, 3.0, 0.0, 0.0}}),
+                                 AutoFnc(Cubic {{0.0, 0.0, 3.0, -2.0}}));
+    CubicHermite h({0_m, 0_m, 0_deg}, {3_m, 1_m, 0_deg}, 3);
+    for (double t : {0.0, 0.3, 0.7, 1.0}) {
+      CHECK(p.calc(t).distTo(h.calc(t)).convert(meter) == Approx(0.0));
+      CHECK(p.curvature(t).convert(1 / meter) == Approx(h.curvature(t).convert(1 / meter)));
+    }
+
+    static_assert(AutoFnc(Cubic {{1.0, 1.0, 1.0, 1.0}}).calc_d2(1.0) == 8.0);
+  }
+
+  SUBCASE("Cached") {
+    CubicHermite h({0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg}, 1.5);
+    CHECK(h.cached_length() == h.length());
+    CHECK(h.cached_length() == h.length());
+    CHECK(h.cached_length(10) == h.length(10));
+    CHECK(h.cached_arc_length() == h.arc_length());
+
+    // a copy starts with an empty cache
+    CubicHermite copy = h;
+    CHECK(copy.cached_arc_length(1e-3_m) == h.arc_length(1e-3_m));
+
+    Arc arc({0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg});
+    CHECK(arc.max_curvature().convert(1 / meter) == Approx(1.0));
+    CHECK(s.max_curvature() == 0 / meter);
+
+    auto [min, max] = s.bounds();
+    CHECK(min == Vector(0_m, 0_m));
+    CHECK(max == Vector(3_m, 3_m));
+  }
+}
+
+// compare a single-precision spline against its double-precision reference
+template <class F, class D> void compare(const F& f, const D& d) {
+  std::vector<double> ts;
+  for (size_t i = 0; i <= 100; ++i) {
+    ts.push_back(i / 100.0);
+  }
+  std::vector<State> f_batch(ts.size());
+  std::vector<State> d_batch(ts.size());
+  f.calc_batch(ts, f_batch);
+  d.calc_batch(ts, d_batch);
+  for (size_t i = 0; i < ts.size(); ++i) {
+    double t = ts[i];
+    REQUIRE(f.calc(t).distTo(d.calc(t)) < 1e-5_m);
+    REQUIRE(f_batch[i].distTo(d_batch[i]) < 1e-5_m);
+    REQUIRE(f.velocity(t).convert(meter) == Approx(d.velocity(t).convert(meter)).epsilon(1e-5));
+    auto fk = f.curvature(t).convert(1 / meter);
+    auto dk = d.curvature(t).convert(1 / meter);
+    REQUIRE(std::abs(fk - dk) < 1e-4 * std::max(1.0, std::abs(dk)));
+  }
+  REQUIRE(f.arc_length().convert(meter) == Approx(d.arc_length().convert(meter)).epsilon(1e-5));
+}
+
+TEST_CASE("Float") {
+  SUBCASE("Bezier") {
+    compare(Bezier<3, float>({{0_m, 0_m}, {0_m, 3_m}, {0.2_m, 0.2_m}, {2_m, 2_m}}),
+            CubicBezier({{0_m, 0_m}, {0_m, 3_m}, {0.2_m, 0.2_m}, {2_m, 2_m}}));
+    std::array<Vector, 6> ctrls {
+      {{0_m, 0_m}, {1_m, 2_m}, {2_m, 3_m}, {3_m, 1_m}, {4_m, 0_m}, {3_m, 3_m}}};
+    compare(Bezier<5, float>(ctrls), QuinticBezier(ctrls));
+  }
+
+  SUBCASE("Hermite") {
+    compare(Hermite<3, float>({0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg}, 1.5),
+            CubicHermite({0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg}, 1.5));
+    compare(Hermite<5, float>({1_ft, 2_ft, 45_deg}, {3_ft, 1_ft, -30_deg}),
+            QuinticHermite({1_ft, 2_ft, 45_deg}, {3_ft, 1_ft, -30_deg}));
+  }
+
+  SUBCASE("Piecewise") {
+    compare(make_piecewise<Hermite<5, float>>(
+              {{0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg}, {0_m, 2_m, 180_deg}, {-1_m, 3_m, 90_deg}}),
+            make_piecewise<QuinticHermite>(
+              {{0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg}, {0_m, 2_m, 180_deg}, {-1_m, 3_m, 90_deg}}));
+  }
 }
 } // namespace test
@@ -1,4 +1,6 @@
 #include "lib7842/api/positioning/spline/piecewise.hpp"
+#include "lib7842/api/positioning/spline/arc.hpp"
+#include "lib7842/api/positioning/spline/hermite.hpp"
 #include "lib7842/test/test.hpp"
 #include "line.hpp"
 namespace test {
@@ -32,5 +34,50 @@ TEST_CASE("Piecewise") {
       REQUIRE(l[i] == State(i / 2.5 * meter, i / 2.5 * meter, 45_deg));
     }
   }
+
+  SUBCASE("ArcLength") {
+    auto l = make_piecewise<Line>({{0_m, 0_m}, {3_m, 4_m}, {3_m, 5_m}});
+    CHECK(l.arc_length().convert(meter) == Approx(6.0));
+  }
+
+  SUBCASE("Dynamic") {
+    auto l = make_piecewise<Line>(std::vector<Vector> {{0_m, 0_m}, {3_m, 4_m}, {3_m, 5_m}});
+    REQUIRE(l.size() == 2);
+    CHECK(l.arc_length().convert(meter) == Approx(6.0));
+
+    // t is spread out by length, so half of t is half of the distance
+    State mid = l.calc(0.5);
+    CHECK(mid.x.convert(meter) == Approx(1.8));
+    CHECK(mid.y.convert(meter) == Approx(2.4));
+    CHECK(l.calc(1.0) == State(3_m, 5_m, 90_deg));
+
+    // the speed is constant across splines of different length
+    CHECK(l.velocity(0.2).convert(meter) == Approx(6.0));
+    CHECK(l.velocity(0.9).convert(meter) == Approx(6.0));
+    CHECK(l.evaluate(0.9).velocity.convert(meter) == Approx(6.0));
+    CHECK(l.t_at_dist_travelled(0.0, 5.5_m) == Approx(5.5 / 6.0));
+
+    CHECK_THROWS(make_piecewise<Line>(std::vector<Vector> {{0_m, 0_m}}));
+    CHECK_THROWS(make_piecewise(std::vector<Line> {}));
+  }
+
+  SUBCASE("DynamicHermite") {
+    auto h = make_piecewise<CubicHermite>(
+      std::vector<State> {{0_m, 0_m, 0_deg}, {1_m, 1_m, 45_deg}, {3_m, 1_m, 90_deg}});
+    auto v = h.generate(StepBy::Dist(0.05_m));
+    for (size_t i = 1; i < v.size(); ++i) {
+      CHECK(v[i].distTo(v[i - 1]).convert(meter) == Approx(0.05).epsilon(0.05));
+    }
+    CHECK(v.back().distTo({3_m, 1_m}).convert(meter) < 0.05);
+  }
+
+  SUBCASE("DynamicArc") {
+    std::array<State, 3> waypoints {{{0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg}, {0_m, 2_m, 180_deg}}};
+    auto a = make_piecewise<Arc>(std::span<const State>(waypoints));
+    REQUIRE(a.size() == 2);
+    CHECK(a.calc(1.0).distTo({0_m, 2_m}).convert(meter) == Approx(0.0));
+    CHECK_THROWS_AS(make_piecewise<Arc>(std::span<const State>(waypoints).first(1)),
+                    std::invalid_argument);
+  }
 }
 } // namespace test
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "lib7842/api/positioning/spline/stepper.hpp"
 #include "lib7842/api/other/units.hpp"
 #include "lib7842/api/positioning/point/vector.hpp"
+#include "lib7842/api/positioning/spline/arc.hpp"
+#include "lib7842/api/positioning/spline/bezier.hpp"
 #include "lib7842/api/positioning/spline/line.hpp"
 
 #include "lib7842/test/test.hpp"
@@ -57,6 +59,63 @@ TEST_CASE("Stepper") {
       }
     }
 
+    SUBCASE("Adaptive") {
+      auto v = Line({0_m, 0_m}, {0_m, 1_m}).generate(StepBy::Adaptive(1_mm, 0.3_m));
+      REQUIRE(v.size() == 5);
+      CHECK(v.front() == Vector(0_m, 0_m));
+      CHECK(v.back().y.convert(meter) == Approx(1.0));
+
+      // a tighter tolerance needs more points in a turn
+      Arc arc({0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg});
+      auto coarse = arc.generate(StepBy::Adaptive(10_mm, 1_m));
+      auto fine = arc.generate(StepBy::Adaptive(1_mm, 1_m));
+      CHECK(coarse.size() < fine.size());
+      CHECK(fine.back().distTo({1_m, 1_m}).convert(meter) == Approx(0.0));
+      for (size_t j = 1; j < fine.size(); ++j) {
+        // the sagitta of each chord across the unit circle
+        double c = fine[j].distTo(fine[j - 1]).convert(meter);
+        CHECK(1.0 - std::sqrt(1.0 - c * c / 4.0) <= 1.001e-3);
+      }
+
+      // the velocity is zero at the start of a cusp, so the curvature is undefined
+      auto cusp = CubicBezier({{0_m, 0_m}, {0_m, 0_m}, {1_m, 1_m}, {2_m, 0_m}})
+                    .generate(StepBy::Adaptive(1_cm, 10_cm));
+      REQUIRE(cusp.size() > 2);
+      CHECK(cusp.back().distTo({2_m, 0_m}).convert(meter) == Approx(0.0));
+    }
+
+    SUBCASE("Ranges") {
+      auto i = Line({0_m, 0_m}, {0_m, 1_m}).step(StepBy::Count(100));
+      static_assert(std::ranges::forward_range<decltype(i)>);
+      static_assert(std::ranges::view<decltype(i)>);
+      auto ys = i | std::views::transform([](const State& s) { return s.y; }) |
+                std::views::take_while([](const QLength& y) { return y < 0.5_m; });
+      CHECK(std::ranges::distance(ys) == 50);
+      CHECK(std::ranges::count_if(i, [](const State& s) { return s.y >= 0.5_m; }) == 51);
+      CHECK(std::ranges::next(i.begin(), 101) == std::default_sentinel);
+    }
+
+    SUBCASE("Fixed") {
+      constexpr auto v = Line({0_m, 0_m}, {0_m, 1_m}).generate<100>();
+      static_assert(v.size() == 101);
+      static_assert(v[50] == State(0_m, 0.5_m, 90_deg));
+      auto w = Line({0_m, 0_m}, {0_m, 1_m}).generate(StepBy::Count(100));
+      REQUIRE(std::ranges::equal(v, w));
+    }
+
+    SUBCASE("Batch") {
+      auto i = Stepper(Arc({0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg}), StepBy::Count(100));
+      auto v = i.generate();
+      REQUIRE(v.size() == 101);
+      size_t j = 0;
+      for (auto&& point : i) {
+        CHECK(v.at(j).x.convert(meter) == Approx(point.x.convert(meter)));
+        CHECK(v.at(j).y.convert(meter) == Approx(point.y.convert(meter)));
+        CHECK(v.at(j).theta.convert(radian) == Approx(point.theta.convert(radian)));
+        ++j;
+      }
+    }
+
     SUBCASE("Step") {
       SUBCASE("Lvalue") {
         DontCopy l;
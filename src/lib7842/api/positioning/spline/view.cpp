@@ -0,0 +1,58 @@
+#include "lib7842/api/positioning/spline/view.hpp"
+#include "lib7842/api/positioning/spline/bezier.hpp"
+#include "lib7842/api/positioning/spline/hermite.hpp"
+#include "lib7842/test/test.hpp"
+namespace test {
+// check that a view samples the same as an equivalent spline
+void same(const Spline& view, const Spline& ref) {
+  for (double t : {0.0, 0.2, 0.5, 0.8, 1.0}) {
+    State a = view.calc(t);
+    State b = ref.calc(t);
+    CHECK(a.distTo(b).convert(meter) == Approx(0.0));
+    CHECK(util::rollAngle180(a.theta - b.theta).convert(degree) == Approx(0.0));
+    CHECK(view.curvature(t).convert(1 / meter) == Approx(ref.curvature(t).convert(1 / meter)));
+    CHECK(view.velocity(t).convert(meter) == Approx(ref.velocity(t).convert(meter)));
+    CHECK(view.calc_d(t).distTo(ref.calc_d(t)).convert(meter) == Approx(0.0));
+    CHECK(view.calc_d2(t).distTo(ref.calc_d2(t)).convert(meter) == Approx(0.0));
+    auto sample = view.evaluate(t);
+    CHECK(sample.state.distTo(b).convert(meter) == Approx(0.0));
+    CHECK(sample.curvature.convert(1 / meter) == Approx(ref.curvature(t).convert(1 / meter)));
+  }
+  CHECK(view.arc_length().convert(meter) == Approx(ref.arc_length().convert(meter)));
+}
+
+TEST_CASE("View") {
+  CubicBezier b({{0_m, 0_m}, {0_m, 2_m}, {1_m, 1_m}, {2_m, 2_m}});
+
+  SUBCASE("Reversed") {
+    same(b.reversed(), CubicBezier({{2_m, 2_m}, {1_m, 1_m}, {0_m, 2_m}, {0_m, 0_m}}));
+  }
+
+  SUBCASE("Mirrored") {
+    same(b.mirrored(Axis::x), CubicBezier({{0_m, 0_m}, {0_m, -2_m}, {1_m, -1_m}, {2_m, -2_m}}));
+    same(b.mirrored(Axis::y), CubicBezier({{0_m, 0_m}, {0_m, 2_m}, {-1_m, 1_m}, {-2_m, 2_m}}));
+    same(CubicHermite({0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg}).mirrored(Axis::x),
+         CubicHermite({0_m, 0_m, 0_deg}, {1_m, -1_m, -90_deg}));
+  }
+
+  SUBCASE("Transformed") {
+    // rotate by 90 degrees, then move
+    same(b.transformed({1_m, 1_m, 90_deg}),
+         CubicBezier({{1_m, 1_m}, {-1_m, 1_m}, {0_m, 2_m}, {-1_m, 3_m}}));
+  }
+
+  SUBCASE("Chained") {
+    // the other side of a 4m field
+    auto other = b.mirrored(Axis::y).transformed({4_m, 0_m, 0_deg}).reversed();
+    same(other, CubicBezier({{2_m, 2_m}, {3_m, 1_m}, {4_m, 2_m}, {4_m, 0_m}}));
+    auto v = other.generate(StepBy::Count(10));
+    CHECK(v.front().distTo({2_m, 2_m}).convert(meter) == Approx(0.0));
+  }
+
+  SUBCASE("Reference") {
+    // a view of an lvalue only holds a reference
+    CHECK(sizeof(b.reversed()) < sizeof(b));
+    CHECK(sizeof(CubicBezier(b).reversed()) > sizeof(b));
+  }
+}
+} // namespace test
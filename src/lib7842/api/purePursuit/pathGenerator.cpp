@@ -1,5 +1,6 @@
 #include "lib7842/api/purePursuit/pathGenerator.hpp"
 #include "lib7842/api/positioning/point/mathPoint.hpp"
+#include "lib7842/api/positioning/spline/hermite.hpp"
 #include "lib7842/api/positioning/spline/line.hpp"
 
 namespace lib7842 {
@@ -13,31 +14,6 @@ void PathGenerator::setCurvatures(std::vector<Waypoint>& ipath) {
   ipath.back().curvature = 0.0 / meter;
 }
 
-void PathGenerator::setVelocity(std::vector<Waypoint>& ipath, const PursuitLimits& limits) {
-  ipath.back().velocity = limits.finalVel;
-  for (size_t i = ipath.size() - 1; i > 0; i--) {
-    auto& start = ipath[i];
-    auto& end = ipath[i - 1];
-
-    // k / curvature, limited to max
-    QSpeed wantedVel =
-      limits.k ? std::min(limits.maxVel, limits.k.value() / ipath[i].curvature.convert(1 / meter))
-               : limits.maxVel;
-
-    // distance from last point
-    double distance = MathPoint::dist(start, end);
-
-    // maximum velocity given distance respecting acceleration
-    // vf = sqrt(vi2 + 2ad)
-    QSpeed maxIncrement = mps * std::sqrt(std::pow(start.velocity.convert(mps), 2) +
-                                          (2.0 * limits.decel.convert(mps2) * distance));
-
-    // limiting to maximum accelerated velocity
-    QSpeed newVel = std::min(wantedVel, maxIncrement);
-    end.velocity = newVel;
-  }
-}
-
 double PathGenerator::calculateCurvature(const Vector& prev, const Vector& point,
                                          const Vector& next) {
   double distOne = MathPoint::dist(point, prev);
@@ -133,5 +109,32 @@ TEST_CASE("PathGenerator") {
     auto z = PathGenerator::generate(p, limits);
     REQUIRE(z[0].velocity == 8_mps);
   }
+
+  SUBCASE("GenerateFixed") {
+    constexpr PursuitLimits fixedLimits {2_mps, 8_mps2, 8_mps, 8_mps2, 3_mps, 0.03_mps};
+    constexpr auto z = PathGenerator::generate<100>(
+      QuinticHermite({0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg}), fixedLimits);
+    static_assert(z.size() == 101);
+    static_assert(z.back().velocity == 3_mps);
+
+    auto v = PathGenerator::generate(
+      QuinticHermite({0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg}).step(StepBy::Count(100)), limits);
+    REQUIRE(v.size() == z.size());
+    for (size_t i = 0; i < v.size(); ++i) {
+      CHECK(z[i].x.convert(meter) == Approx(v[i].x.convert(meter)));
+      CHECK(z[i].curvature.convert(1 / meter) == Approx(v[i].curvature.convert(1 / meter)));
+      CHECK(z[i].velocity.convert(mps) == Approx(v[i].velocity.convert(mps)));
+    }
+  }
+
+  SUBCASE("GenerateView") {
+    auto p = Line({{0_m, 0_m}, {0_m, 5_m}}).step(StepBy::T(0.01)) |
+             std::views::filter([](const State& s) { return s.y <= 2_m; });
+    auto z = PathGenerator::generate(p, limits);
+    REQUIRE(z.size() == 41);
+    // decelerating from the first waypoint to the final velocity over 2 meters
+    REQUIRE(z[0].velocity.convert(mps) == Approx(std::sqrt(3.0 * 3.0 + 2.0 * 8.0 * 2.0)));
+    REQUIRE(z.back().velocity == 3_mps);
+  }
 }
 } // namespace test
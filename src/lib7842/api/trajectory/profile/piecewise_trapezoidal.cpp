@@ -0,0 +1,52 @@
+#include "lib7842/api/trajectory/profile/piecewise_trapezoidal.hpp"
+#include "lib7842/test/test.hpp"
+namespace test {
+TEST_CASE("PiecewiseProfile") {
+  Limits<> limits(2_mps2, 1.5_mps, 360_deg / second);
+  PiecewiseTrapezoidal profile(limits, 4_m, {},
+                               {{20_pct, 50_pct}, {40_pct, 100_pct}, {70_pct, 20_pct}});
+
+  SUBCASE("Ends") {
+    CHECK(profile.begin().t == 0_s);
+    CHECK(profile.begin().d == 0_m);
+    CHECK(profile.end().d.convert(meter) == Approx(4.0));
+    CHECK(profile.end().v.convert(mps) == Approx(0.0));
+    CHECK(profile.calc(profile.end().t).d.convert(meter) == Approx(4.0));
+    CHECK(profile.calc(profile.end().d).t.convert(second) ==
+          Approx(profile.end().t.convert(second)));
+  }
+
+  SUBCASE("Markers") {
+    CHECK(profile.calc(0.8_m).v.convert(mps) == Approx(0.75));
+    CHECK(profile.calc(1.6_m).v.convert(mps) == Approx(1.5));
+    CHECK(profile.calc(2.8_m).v.convert(mps) == Approx(0.3));
+  }
+
+  SUBCASE("RoundTrip") {
+    // the states are relative to the start of the piecewise, not the start of each profile
+    for (size_t i = 0; i <= 100; ++i) {
+      QLength d = 4_m * (i / 100.0);
+      auto k = profile.calc(d);
+      CHECK(k.d.convert(meter) == Approx(d.convert(meter)));
+      auto k2 = profile.calc(k.t);
+      CHECK(k2.t.convert(second) == Approx(k.t.convert(second)));
+      CHECK(k2.d.convert(meter) == Approx(d.convert(meter)));
+      CHECK(k2.v.convert(mps) == Approx(k.v.convert(mps)));
+    }
+  }
+
+  SUBCASE("Cursor") {
+    auto cursor = profile.cursor();
+    for (size_t i = 0; i <= 100; ++i) {
+      QLength d = 4_m * (i / 100.0);
+      CHECK(cursor.calc(d).v == profile.calc(d).v);
+    }
+    // moving backwards searches again
+    CHECK(cursor.calc(1_m).v == profile.calc(1_m).v);
+    for (size_t i = 0; i <= 100; ++i) {
+      QTime t = profile.end().t * (i / 100.0);
+      CHECK(cursor.calc(t).d == profile.calc(t).d);
+    }
+  }
+}
+} // namespace test
@@ -0,0 +1,80 @@
+#include "lib7842/api/trajectory/profile/s_curve.hpp"
+#include "lib7842/api/trajectory/profile/piecewise_trapezoidal.hpp"
+#include "lib7842/api/trajectory/profile/trapezoidal.hpp"
+#include "lib7842/test/test.hpp"
+namespace test {
+TEST_CASE("SCurve") {
+  Limits<> limits(2_mps2, 1.5_mps, 360_deg / second);
+  Limits<> jerky = limits.with_jerk(0.25_s);
+
+  SUBCASE("NoJerk") {
+    // without a jerk limit the profile is a trapezoid
+    for (auto length : {0.5_m, 3_m}) {
+      SCurve<> profile(limits, length, {.start_v = 10_pct, .end_v = 20_pct});
+      Trapezoidal<> trapezoid(limits, length, {.start_v = 10_pct, .end_v = 20_pct});
+      CHECK(profile.end().t.convert(second) == Approx(trapezoid.end().t.convert(second)));
+      for (double x : {0.1, 0.3, 0.5, 0.9}) {
+        QTime t = trapezoid.end().t * x;
+        CHECK(profile.calc(t).v.convert(mps) == Approx(trapezoid.calc(t).v.convert(mps)));
+        QLength d = length * x;
+        CHECK(profile.calc(d).t.convert(second) == Approx(trapezoid.calc(d).t.convert(second)));
+      }
+    }
+  }
+
+  SUBCASE("Limits") {
+    for (auto length : {0.2_m, 0.8_m, 3_m}) {
+      SCurve<> profile(jerky, length);
+      QTime dt = profile.end().t / 1000;
+      auto last = profile.begin();
+      CHECK(last.a.convert(mps2) == Approx(0.0));
+      for (size_t i = 1; i <= 1000; ++i) {
+        auto k = profile.calc(dt * i);
+        CHECK(k.v.convert(mps) <= 1.5 + 1e-9);
+        CHECK(k.a.abs().convert(mps2) <= 2.0 + 1e-9);
+        CHECK(((k.a - last.a) / dt).abs().convert(mps2 / second) <= 8.0 + 1e-6);
+        CHECK((k.v - last.v).convert(mps) == Approx((dt * (k.a + last.a) / 2).convert(mps)));
+        last = k;
+      }
+      CHECK(last.d.convert(meter) == Approx(length.convert(meter)));
+      CHECK(last.v.convert(mps) == Approx(0.0));
+      // the smoother profile takes longer than a trapezoid
+      CHECK(profile.end().t > Trapezoidal<>(limits, length).end().t);
+    }
+  }
+
+  SUBCASE("Flags") {
+    SCurve<> profile(jerky, 2_m, {.start_v = 20_pct, .end_v = 40_pct, .top_v = 80_pct});
+    CHECK(profile.begin().v.convert(mps) == Approx(0.3));
+    CHECK(profile.end().v.convert(mps) == Approx(0.6));
+    CHECK(profile.calc(1_m).v.convert(mps) == Approx(1.2));
+    CHECK_THROWS(SCurve<>(jerky, 0.01_m, {.start_v = 100_pct}));
+  }
+
+  SUBCASE("RoundTrip") {
+    for (auto length : {0.3_m, 3_m}) {
+      SCurve<> profile(jerky, length, {.start_v = 30_pct});
+      for (size_t i = 0; i <= 100; ++i) {
+        auto k = profile.calc(profile.end().t * (i / 100.0));
+        auto k2 = profile.calc(k.d);
+        CHECK(k2.t.convert(second) == Approx(k.t.convert(second)));
+        CHECK(k2.v.convert(mps) == Approx(k.v.convert(mps)));
+      }
+    }
+  }
+
+  SUBCASE("Angle") {
+    Limits<QAngle> angular(0.5_s, 90_deg / second);
+    SCurve<QAngle> profile(angular.with_jerk(0.1_s), 90_deg);
+    CHECK(profile.end().d.convert(degree) == Approx(90.0));
+    CHECK(profile.calc(45_deg).t.convert(second) ==
+          Approx((profile.end().t / 2).convert(second)));
+  }
+
+  SUBCASE("Piecewise") {
+    PiecewiseSCurve profile(jerky, 3_m, {}, {{50_pct, 20_pct}});
+    CHECK(profile.calc(1.5_m).v.convert(mps) == Approx(0.3));
+    CHECK(profile.calc(3_m).v.convert(mps) == Approx(0.0));
+  }
+}
+} // namespace test
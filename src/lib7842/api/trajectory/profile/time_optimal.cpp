@@ -0,0 +1,88 @@
+#include "lib7842/api/trajectory/profile/time_optimal.hpp"
+#include "lib7842/api/positioning/spline/hermite.hpp"
+#include "lib7842/api/positioning/spline/line.hpp"
+#include "lib7842/api/trajectory/profile/trapezoidal.hpp"
+#include "lib7842/test/test.hpp"
+namespace test {
+TEST_CASE("TimeOptimal") {
+  Limits<> limits(2_mps2, 1.5_mps, 360_deg / second);
+
+  SUBCASE("Straight") {
+    // without any curvature the profile is a trapezoid
+    Line line({0_m, 0_m}, {0_m, 3_m});
+    TimeOptimal profile(limits, line);
+    Trapezoidal<> trapezoid(limits, 3_m);
+    CHECK(profile.end().t.convert(second) ==
+          Approx(trapezoid.end().t.convert(second)).epsilon(0.01));
+    for (auto d : {0.2_m, 0.5_m, 1.5_m, 2.8_m}) {
+      CHECK(profile.calc(d).v.convert(mps) ==
+            Approx(trapezoid.calc(d).v.convert(mps)).epsilon(0.01));
+    }
+  }
+
+  SUBCASE("Flags") {
+    Line line({0_m, 0_m}, {0_m, 3_m});
+    TimeOptimal profile(limits, line, {.start_v = 20_pct, .end_v = 40_pct, .top_v = 80_pct});
+    CHECK(profile.begin().v.convert(mps) == Approx(0.3));
+    CHECK(profile.end().v.convert(mps) == Approx(0.6));
+    CHECK(profile.end().vel.convert(mps) == Approx(1.2));
+    CHECK(profile.end().d.convert(meter) == Approx(3.0));
+    CHECK(profile.table().length() == profile.end().d);
+  }
+
+  SUBCASE("Feasible") {
+    // a path with a tight turn in the middle
+    QuinticHermite path({0_m, 0_m, 0_deg}, {0.5_m, 1_m, 180_deg});
+    TimeOptimal profile(limits, path, {}, {}, 1_mps2);
+    LengthTable table(path);
+    const auto& vels = profile.velocities();
+    QLength ds = table.length() / (vels.size() - 1);
+    size_t turn = 0;
+    QCurvature max_c {0.0};
+    for (size_t i = 0; i < vels.size(); ++i) {
+      QCurvature c = path.curvature(table.t_at_length(ds * i)).abs();
+      if (c > max_c) {
+        max_c = c;
+        turn = i;
+      }
+      CHECK(vels[i] <= limits.max_vel_at_curvature(c) + 1e-9_mps);
+      CHECK((square(vels[i]) * c).convert(mps2) <= 1.0 + 1e-9);
+      if (i > 0) {
+        auto a = (square(vels[i]) - square(vels[i - 1])) / (2 * ds);
+        CHECK(a.abs().convert(mps2) <= 2.0 + 1e-9);
+      }
+    }
+    // the robot slows down before the turn
+    REQUIRE(turn > 0);
+    CHECK(*std::max_element(vels.begin(), vels.begin() + turn) > vels[turn]);
+  }
+
+  SUBCASE("Markers") {
+    Line line({0_m, 0_m}, {0_m, 3_m});
+    TimeOptimal profile(limits, line, {}, {{50_pct, 20_pct}});
+    CHECK(profile.calc(1.5_m).v.convert(mps) == Approx(0.3));
+    CHECK_THROWS_AS(TimeOptimal(limits, line, {}, {{120_pct, 20_pct}}), std::invalid_argument);
+    CHECK_THROWS_AS(TimeOptimal(limits, line, {}, {{-10_pct, 20_pct}}), std::invalid_argument);
+  }
+
+  SUBCASE("Spacing") {
+    // the number of samples follows the length, not the shape of the spline
+    Line line({0_m, 0_m}, {0_m, 3_m});
+    CHECK(TimeOptimal(limits, line).velocities().size() == 301);
+    CHECK(TimeOptimal(limits, line, {}, {}, std::nullopt, 5_cm).velocities().size() == 61);
+    CHECK_THROWS_AS(TimeOptimal(limits, line, {}, {}, std::nullopt, 0_m), std::invalid_argument);
+  }
+
+  SUBCASE("RoundTrip") {
+    QuinticHermite path({0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg});
+    TimeOptimal profile(limits, path);
+    for (auto d : {0_m, 0.3_m, 0.77_m, 1.2_m}) {
+      auto k = profile.calc(d);
+      auto k2 = profile.calc(k.t);
+      CHECK(k2.d.convert(meter) == Approx(d.convert(meter)));
+      CHECK(k2.v.convert(mps) == Approx(k.v.convert(mps)));
+    }
+    CHECK(profile.calc(profile.end().t).d.convert(meter) == Approx(profile.end().d.convert(meter)));
+  }
+}
+} // namespace test
@@ -6,60 +6,120 @@ namespace lib7842 {
 Generator::Output SkidSteerGenerator::follow(const Spline& spline, bool forward,
                                              const Profile<>::Flags& flags,
                                              const PiecewiseTrapezoidal::Markers& markers) {
-#ifdef THREADS_STD
-  std::vector<Generator::Step> trajectory;
-#endif
-  if (model && flags.start_v == 0_pct) {
-    model->stop();
-    pros::delay(10);
-  }
+  return follow<Spline>(spline, forward, flags, markers);
+}
 
-  auto runner = [&](double t, Profile<>::State& k) {
-#ifdef THREADS_STD
-    auto profiled_vel = k.v; // used for logging
-#endif
+Generator::Trajectory SkidSteerGenerator::plan(const Spline& spline, bool forward,
+                                               const Profile<>::Flags& flags,
+                                               const PiecewiseTrapezoidal::Markers& markers) {
+  return plan<Spline>(spline, forward, flags, markers);
+}
 
-    // get the curvature along the path
-    auto curvature = spline.curvature(t);
-    // limit the velocity according to curvature.
-    // since this is passed by reference it will affect the generator code
-    k.v = std::min(k.v, limits.max_vel_at_curvature(curvature));
+void SkidSteerGenerator::execute(const Generator::Trajectory& trajectory) {
+  execute(trajectory.steps, trajectory.dt, trajectory.profile.begin().v / limits.v);
+}
+
+void SkidSteerGenerator::execute(std::span<const Generator::Step> steps, const QTime& idt,
+                                 const Number& start_v) {
+  prepare(start_v);
+  Generator::execute(steps, idt, [&](const Generator::Step& step) {
+    if (model) {
+      model->left(step.left);
+      model->right(step.right);
+    }
+  });
+}
 
-    // angular speed is curvature times limited speed
-    QAngularSpeed w = curvature * k.v * radian;
+void SkidSteerGenerator::prepare(const Number& start_v) {
+  if (model && start_v == 0_pct) {
+    model->stop();
+    pros::delay(10);
+  }
+}
 
-    // scale down motor speed if x drive
-    auto vel = k.v;
-    if (isXdrive) { vel /= std::sqrt(2); }
+} // namespace lib7842
 
-    QSpeed left = vel - (w / radian * scales.wheelTrack) / 2;
-    QSpeed right = vel + (w / radian * scales.wheelTrack) / 2;
+#include "lib7842/api/positioning/spline/hermite.hpp"
+#include "lib7842/test/test.hpp"
+namespace test {
+TEST_CASE("SkidSteerGenerator") {
+  ChassisScales scales({3.25_in, 13_in}, 360);
+  Limits<> limits(scales, 200_rpm, 0.6_s);
+  SkidSteerGenerator generator(nullptr, 200_rpm, scales, limits, 10_ms);
+  QuinticHermite path({0_ft, 0_ft, 0_deg}, {4_ft, 2_ft, 45_deg});
 
-    auto leftSpeed = Generator::toWheel(left, scales, gearset).convert(number);
-    auto rightSpeed = Generator::toWheel(right, scales, gearset).convert(number);
+  SUBCASE("Plan") {
+    auto trajectory = generator.plan(path);
+    auto& steps = trajectory.steps;
+    REQUIRE(steps.size() > 2);
+    CHECK(trajectory.dt == 10_ms);
+    // one step per timeslice, plus the final stop
+    CHECK((steps.size() * 10_ms).convert(second) ==
+          Approx((trajectory.profile.end().t + 10_ms).convert(second)).epsilon(0.1));
+    CHECK(steps.front().p.distTo(path.calc(0)).convert(meter) == Approx(0.0));
+    CHECK(steps.back().p.distTo(path.calc(1)).convert(meter) == Approx(0.0));
+    CHECK(steps.back().left == Approx(0.0));
+    CHECK(steps.back().right == Approx(0.0));
+    // the path turns left, so the right wheel is faster
+    CHECK(steps[steps.size() / 4].right > steps[steps.size() / 4].left);
+  }
 
-    if (model) {
-      if (forward) {
-        model->left(leftSpeed);
-        model->right(rightSpeed);
-      } else {
-        model->left(-rightSpeed);
-        model->right(-leftSpeed);
-      }
+  SUBCASE("Static") {
+    // the templated overload calls the spline directly, and the other through the vtable
+    auto dynamic = generator.plan(static_cast<const Spline&>(path));
+    auto direct = generator.plan(path);
+    REQUIRE(dynamic.steps.size() == direct.steps.size());
+    for (size_t i = 0; i < direct.steps.size(); ++i) {
+      CHECK(dynamic.steps[i].p == direct.steps[i].p);
+      CHECK(dynamic.steps[i].left == direct.steps[i].left);
+      CHECK(dynamic.steps[i].right == direct.steps[i].right);
     }
+  }
 
-#ifdef THREADS_STD
-    trajectory.emplace_back(spline.calc(t), k, w, curvature, profiled_vel, leftSpeed, rightSpeed);
-#endif
-  };
+  SUBCASE("TimeOptimal") {
+    CHECK(std::holds_alternative<PiecewiseTrapezoidal>(generator.plan(path).profile));
+    SkidSteerGenerator optimal(nullptr, 200_rpm, scales, limits, 10_ms, false,
+                               TimeOptimalOptions {.centripetal = 1_mps2});
+    auto trajectory = optimal.plan(path);
+    REQUIRE(std::holds_alternative<TimeOptimal>(trajectory.profile));
+    // the speed is already within the curvature limits, so the steps follow the profile
+    for (auto&& step : trajectory.steps) {
+      CHECK(step.k.v.convert(mps) == Approx(step.p_vel.convert(mps)));
+    }
+  }
 
-  auto profile = Generator::generate(limits, runner, spline, dt, flags, markers);
+  SUBCASE("Jerk") {
+    auto jerk = limits.with_jerk(0.2_s);
+    SkidSteerGenerator scurve(nullptr, 200_rpm, scales, jerk, 10_ms);
+    auto trajectory = scurve.plan(path);
+    REQUIRE(std::holds_alternative<PiecewiseSCurve>(trajectory.profile));
+    // the acceleration ramps up, so the robot takes longer than without a jerk limit
+    CHECK(trajectory.steps.size() > generator.plan(path).steps.size());
+    CHECK_THROWS_AS(SkidSteerGenerator(nullptr, 200_rpm, scales, jerk, 10_ms, false,
+                                       TimeOptimalOptions {}),
+                    std::invalid_argument);
+  }
 
 #ifdef THREADS_STD
-  return std::make_pair(profile, trajectory);
-#else
-  return profile;
+  SUBCASE("Follow") {
+    auto trajectory = generator.plan(path);
+    auto [profile, steps] = generator.follow(path);
+    REQUIRE(steps.size() == trajectory.steps.size());
+    for (size_t i = 0; i < steps.size(); ++i) {
+      CHECK(steps[i].left == trajectory.steps[i].left);
+      CHECK(steps[i].right == trajectory.steps[i].right);
+    }
+  }
 #endif
-}
 
-} // namespace lib7842
+  SUBCASE("Backward") {
+    auto forward = generator.plan(path);
+    auto backward = generator.plan(path, false);
+    REQUIRE(forward.steps.size() == backward.steps.size());
+    for (size_t i = 0; i < forward.steps.size(); ++i) {
+      CHECK(backward.steps[i].left == -forward.steps[i].right);
+      CHECK(backward.steps[i].right == -forward.steps[i].left);
+    }
+  }
+}
+} // namespace test
@@ -0,0 +1,181 @@
+#include "lib7842/api/trajectory/generator/trajectoryFile.hpp"
+#include <cstdio>
+#include <stdexcept>
+
+#ifdef THREADS_STD
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace lib7842 {
+
+#ifdef THREADS_STD
+TrajectoryFile::TrajectoryFile(const std::string& filename) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) { throw std::runtime_error("TrajectoryFile: could not open " + filename); }
+  struct stat info {};
+  if (fstat(fd, &info) != 0 || info.st_size == 0) {
+    close(fd);
+    throw std::runtime_error("TrajectoryFile: could not read " + filename);
+  }
+  size = static_cast<size_t>(info.st_size);
+  void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) { throw std::runtime_error("TrajectoryFile: could not map " + filename); }
+  data = static_cast<const std::byte*>(map);
+  try {
+    validate();
+  } catch (...) {
+    munmap(const_cast<std::byte*>(data), size);
+    throw;
+  }
+}
+
+TrajectoryFile::~TrajectoryFile() { munmap(const_cast<std::byte*>(data), size); }
+#else
+TrajectoryFile::TrajectoryFile(const std::string& filename) {
+  FILE* file = fopen(filename.c_str(), "rb");
+  if (!file) { throw std::runtime_error("TrajectoryFile: could not open " + filename); }
+  fseek(file, 0, SEEK_END);
+  long end = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  if (end <= 0) {
+    fclose(file);
+    throw std::runtime_error("TrajectoryFile: could not read " + filename);
+  }
+  size = static_cast<size_t>(end);
+  // new aligns the buffer for any fundamental type, so the steps can be used in place
+  buffer = std::make_unique<std::byte[]>(size);
+  size_t read = fread(buffer.get(), 1, size, file);
+  fclose(file);
+  if (read != size) { throw std::runtime_error("TrajectoryFile: could not read " + filename); }
+  data = buffer.get();
+  validate();
+}
+
+TrajectoryFile::~TrajectoryFile() = default;
+#endif
+
+void TrajectoryFile::validate() const {
+  if (size < sizeof(Header) || header().magic != magic) {
+    throw std::runtime_error("TrajectoryFile: not a trajectory file");
+  }
+  if (header().version != version || header().step_size != sizeof(Generator::Step)) {
+    throw std::runtime_error("TrajectoryFile: incompatible version");
+  }
+  // compare the count by division, since a corrupted count could overflow when multiplied
+  size_t body = size - sizeof(Header);
+  if (body % sizeof(Generator::Step) != 0 || header().count != body / sizeof(Generator::Step)) {
+    throw std::runtime_error("TrajectoryFile: truncated file");
+  }
+}
+
+void TrajectoryFile::save(const std::string& filename, std::span<const Generator::Step> steps,
+                          const QTime& dt, const Limits<>& limits, const ChassisScales& scales,
+                          const Number& start_v, uint64_t hash) {
+  Header header;
+  header.magic = magic;
+  header.version = version;
+  header.step_size = sizeof(Generator::Step);
+  header.count = steps.size();
+  header.hash = hash;
+  header.dt = dt.convert(second);
+  header.start_v = start_v.convert(number);
+  header.a = limits.a.convert(mps2);
+  header.v = limits.v.convert(mps);
+  header.w = limits.w.convert(radps);
+  header.j = limits.j.getValue();
+  header.wheel_diameter = scales.wheelDiameter.convert(meter);
+  header.wheel_track = scales.wheelTrack.convert(meter);
+
+  FILE* file = fopen(filename.c_str(), "wb");
+  if (!file) { throw std::runtime_error("TrajectoryFile: could not open " + filename); }
+  bool ok = fwrite(&header, sizeof(Header), 1, file) == 1 &&
+            fwrite(steps.data(), sizeof(Generator::Step), steps.size(), file) == steps.size();
+  ok = fclose(file) == 0 && ok;
+  if (!ok) { throw std::runtime_error("TrajectoryFile: could not write " + filename); }
+}
+
+void TrajectoryFile::save(const std::string& filename, const Generator::Trajectory& trajectory,
+                          const Limits<>& limits, const ChassisScales& scales, uint64_t hash) {
+  save(filename, trajectory.steps, trajectory.dt, limits, scales,
+       trajectory.profile.begin().v / limits.v, hash);
+}
+
+Limits<> TrajectoryFile::limits() const {
+  Limits<> limits(header().a * mps2, header().v * mps, header().w * radps);
+  limits.j = Limits<>::Jerk {header().j};
+  return limits;
+}
+
+} // namespace lib7842
+
+#include "lib7842/api/positioning/spline/hermite.hpp"
+#include "lib7842/api/trajectory/generator/skidGenerator.hpp"
+#include "lib7842/test/test.hpp"
+#include <filesystem>
+namespace test {
+#ifdef THREADS_STD
+TEST_CASE("TrajectoryFile") {
+  ChassisScales scales({3.25_in, 13_in}, 360);
+  Limits<> limits(scales, 200_rpm, 0.6_s);
+  limits.j = limits.a / 0.2_s;
+  SkidSteerGenerator generator(nullptr, 200_rpm, scales, limits, 10_ms);
+  QuinticHermite path({0_ft, 0_ft, 0_deg}, {4_ft, 2_ft, 45_deg});
+  auto trajectory = generator.plan(path);
+  auto filename = (std::filesystem::temp_directory_path() / "lib7842_trajectory.bin").string();
+
+  TrajectoryFile::save(filename, trajectory, limits, scales, TrajectoryFile::hash(path));
+
+  SUBCASE("Load") {
+    TrajectoryFile file(filename);
+    auto steps = file.steps();
+    REQUIRE(steps.size() == trajectory.steps.size());
+    for (size_t i = 0; i < steps.size(); ++i) {
+      CHECK(steps[i].left == trajectory.steps[i].left);
+      CHECK(steps[i].right == trajectory.steps[i].right);
+      CHECK(steps[i].p.x == trajectory.steps[i].p.x);
+      CHECK(steps[i].p.theta == trajectory.steps[i].p.theta);
+    }
+    CHECK(file.dt() == trajectory.dt);
+    CHECK(file.start_v() == 0_pct);
+    CHECK(file.limits().a == limits.a);
+    CHECK(file.limits().v == limits.v);
+    CHECK(file.limits().w == limits.w);
+    CHECK(file.limits().j == limits.j);
+    CHECK(file.header().wheel_track == Approx(scales.wheelTrack.convert(meter)));
+    CHECK(file.header().hash == TrajectoryFile::hash(path));
+  }
+
+  SUBCASE("Hash") {
+    QuinticHermite other({0_ft, 0_ft, 0_deg}, {4_ft, 2.1_ft, 45_deg});
+    CHECK(TrajectoryFile::hash(path) != TrajectoryFile::hash(other));
+  }
+
+  SUBCASE("Invalid") {
+    auto size = std::filesystem::file_size(filename);
+    SUBCASE("Truncated") { std::filesystem::resize_file(filename, size - 1); }
+    SUBCASE("Count") {
+      // a count whose size in bytes overflows to the size of the file
+      FILE* f = fopen(filename.c_str(), "r+b");
+      uint64_t count = (size - sizeof(TrajectoryFile::Header)) / sizeof(Generator::Step);
+      count += uint64_t {1} << 61;
+      fseek(f, offsetof(TrajectoryFile::Header, count), SEEK_SET);
+      fwrite(&count, sizeof(count), 1, f);
+      fclose(f);
+    }
+    SUBCASE("Magic") {
+      FILE* f = fopen(filename.c_str(), "r+b");
+      fputc('X', f);
+      fclose(f);
+    }
+    CHECK_THROWS_AS(TrajectoryFile {filename}, std::runtime_error);
+  }
+
+  CHECK_THROWS_AS(TrajectoryFile {filename + ".missing"}, std::runtime_error);
+  std::filesystem::remove(filename);
+}
+#endif
+} // namespace test
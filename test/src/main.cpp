@@ -47,6 +47,8 @@ int main(int argc, char** argv) {
                   << step.left << "," << step.right << "," << step.leftBack << "," << step.rightBack
                   << std::endl;
       }
+    } else if (std::string(argv[1]) == "save" && argc > 2) {
+      TrajectoryFile::save(argv[2], t, 10_ms, limits, scales);
     } else if (std::string(argv[1]) == "bench") {
       for (size_t i = 0; i < 1000; i++) {
         move(QuarticBezier({{0_ft, 0_ft}, {0_ft, 1_ft}, {-2_ft, 2_ft}, {2_ft, 4_ft}, {2_ft, 6_ft}}),